@@ -170,12 +170,15 @@ Forwarder::onContentStoreHit(const Face& inFace,
   this->setStragglerTimer(pitEntry, true, data.getFreshnessPeriod());
 
   // give the strategy the final say on whether we
-  // send the data or not, and if so then what data we send
-  auto tx_data = make_shared<Data>(data);
+  // send the data or not, and if so then what data we send;
+  // the data is only copied if the strategy modifies it
+  fw::OutgoingData tx_data( data.shared_from_this() );
   auto delay = ns3::Seconds( 0 );
   fw::Strategy& strategy = m_strategyChoice.findEffectiveStrategy(*pitEntry);
-  if( strategy.filterOutgoingData( inFace, interest, *tx_data, delay ) )
-      this->onOutgoingData(*tx_data, *const_pointer_cast<Face>(inFace.shared_from_this()), delay );
+  if( strategy.filterOutgoingData( inFace, interest, tx_data, delay ) )
+      this->onOutgoingData( this->updateOutgoingRoute( tx_data ),
+                            *const_pointer_cast<Face>(inFace.shared_from_this()),
+                            delay, interest.getNonce() );
 }
 
 void
@@ -363,7 +366,10 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   else
     m_csFromNdnSim->Add(data.shared_from_this());
 
-  std::list< pit::InRecord > pendingDownstreams;
+  // InRecords of the satisfied entries, moved out of the entries
+  // rather than copied; expired ones are skipped when sending
+  pit::InRecordCollection pendingDownstreams;
+  time::steady_clock::TimePoint now = time::steady_clock::now();
   // foreach PitEntry
   for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
     NFD_LOG_DEBUG("onIncomingData matching=" << pitEntry->getName());
@@ -371,15 +377,6 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     // cancel unsatisfy & straggler timer
     this->cancelUnsatisfyAndStragglerTimer(pitEntry);
 
-    // remember pending downstreams
-    const pit::InRecordCollection& inRecords = pitEntry->getInRecords();
-    for (pit::InRecordCollection::const_iterator it = inRecords.begin();
-                                                 it != inRecords.end(); ++it) {
-      if (it->getExpiry() > time::steady_clock::now()) {
-        pendingDownstreams.push_back( *it );
-      }
-    }
-
     // invoke PIT satisfy callback
     beforeSatisfyInterest(*pitEntry, inFace, data);
     this->dispatchToStrategy(pitEntry, bind(&Strategy::beforeSatisfyInterest, _1,
@@ -388,28 +385,64 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     // Dead Nonce List insert if necessary (for OutRecord of inFace)
     this->insertDeadNonceList(*pitEntry, true, data.getFreshnessPeriod(), &inFace);
 
-    // mark PIT satisfied
-    pitEntry->deleteInRecords();
+    // mark PIT satisfied, remembering pending downstreams
+    pitEntry->moveInRecords(pendingDownstreams);
     pitEntry->deleteOutRecord(inFace);
 
     // set PIT straggler timer
     this->setStragglerTimer(pitEntry, true, data.getFreshnessPeriod());
   }
 
-  // foreach pending downstream
+  // downstreams that are sent the data unmodified share a
+  // single copy, since their route update is the same
+  shared_ptr<const Data> routedData;
+
+  // group pending downstreams by strategy, so each strategy
+  // can filter all of its downstreams at once
+  typedef std::vector<fw::Strategy::DataDownstream> Downstreams;
+  std::vector<std::pair<fw::Strategy*, Downstreams>> batches;
   for (auto it = pendingDownstreams.begin();
       it != pendingDownstreams.end(); ++it) {
-    if (it->getFace().get() == &inFace) {
+    if (it->getExpiry() <= now || it->getFace().get() == &inFace) {
       continue;
     }
-    
+
+    fw::Strategy* strategy = &m_strategyChoice.findEffectiveStrategy(it->getInterest().getName());
+    auto batch = std::find_if(batches.begin(), batches.end(),
+      [strategy] (const std::pair<fw::Strategy*, Downstreams>& b) { return b.first == strategy; });
+    if (batch == batches.end()) {
+      batches.emplace_back(strategy, Downstreams());
+      batch = batches.end() - 1;
+    }
+
+    // the data is only copied if the strategy modifies it
+    batch->second.push_back(fw::Strategy::DataDownstream{*it->getFace(), it->getInterest(),
+                                                         fw::OutgoingData(data.shared_from_this()),
+                                                         ns3::Seconds(0), true});
+  }
+
+  for (auto& batch : batches) {
     // give the strategy the final say on whether we
     // send the data or not, and if so then what data we send
-    auto tx_data = make_shared<Data>(data);
-    auto delay = ns3::Seconds( 0 );
-    fw::Strategy& strategy = m_strategyChoice.findEffectiveStrategy(it->getInterest().getName());
-    if( strategy.filterOutgoingData( *it->getFace(), it->getInterest(), *tx_data, delay ) )
-        this->onOutgoingData(*tx_data, *it->getFace(), delay );
+    batch.first->filterOutgoingData(batch.second);
+
+    // foreach pending downstream
+    for (fw::Strategy::DataDownstream& downstream : batch.second) {
+      if( !downstream.send )
+          continue;
+
+      if( downstream.data.isModified() )
+          this->onOutgoingData( this->updateOutgoingRoute( downstream.data ),
+                                downstream.face, downstream.delay,
+                                downstream.interest.getNonce() );
+      else
+      {
+          if( routedData == nullptr )
+              routedData = this->updateOutgoingRoute( downstream.data );
+          this->onOutgoingData( routedData, downstream.face, downstream.delay,
+                                downstream.interest.getNonce() );
+      }
+    }
   }
 }
 
@@ -431,26 +464,31 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
                 (acceptToCache ? " cached" : " not cached"));
 }
 
+shared_ptr<const Data>
+Forwarder::updateOutgoingRoute(fw::OutgoingData& data)
+{
+  // update route hash
+  if( data.get().hasRouteTracker() )
+    data.modify().updateRoute( m_route_id );
+  return data.share();
+}
+
 void
-Forwarder::onOutgoingData(const Data& data, Face& outFace, ns3::Time delay )
+Forwarder::onOutgoingData(shared_ptr<const Data> data, Face& outFace, ns3::Time delay,
+                          int64_t nonce)
 {
   if (outFace.getId() == INVALID_FACEID) {
-    NFD_LOG_WARN("onOutgoingData face=invalid data=" << data.getName());
+    NFD_LOG_WARN("onOutgoingData face=invalid data=" << data->getName());
     return;
   }
-  NFD_LOG_DEBUG("onOutgoingData face=" << outFace.getId() << " data=" << data.getName());
+  NFD_LOG_DEBUG("onOutgoingData face=" << outFace.getId() << " data=" << data->getName());
 
-
-  // update route hash
-  if( data.hasRouteTracker() )
-    const_cast<Data&>(data).updateRoute( m_route_id );
-  
   // /localhost scope control
   bool isViolatingLocalhost = !outFace.isLocal() &&
-                              LOCALHOST_NAME.isPrefixOf(data.getName());
+                              LOCALHOST_NAME.isPrefixOf(data->getName());
   if (isViolatingLocalhost) {
     NFD_LOG_DEBUG("onOutgoingData face=" << outFace.getId() <<
-                  " data=" << data.getName() << " violates /localhost");
+                  " data=" << data->getName() << " violates /localhost");
     // (drop)
     return;
   }
@@ -459,7 +497,7 @@ Forwarder::onOutgoingData(const Data& data, Face& outFace, ns3::Time delay )
 
   // send Data
   m_tx_queue.delay( delay );
-  m_tx_queue.sendData( outFace.shared_from_this(), data.shared_from_this() );
+  m_tx_queue.sendData( outFace.shared_from_this(), data, nonce );
   ++m_counters.getNOutDatas();
 }
 
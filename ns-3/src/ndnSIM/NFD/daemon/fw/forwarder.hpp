@@ -43,6 +43,7 @@
 #include "table/strategy-choice.hpp"
 #include "table/dead-nonce-list.hpp"
 #include "tx-queue.hpp"
+#include "outgoing-data.hpp"
 
 #include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
 
@@ -196,7 +197,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   /** \brief outgoing Data pipeline
    */
   VIRTUAL_WITH_TESTS void
-  onOutgoingData(const Data& data, Face& outFace, ns3::Time delay );
+  onOutgoingData(shared_ptr<const Data> data, Face& outFace, ns3::Time delay,
+                 int64_t nonce = -1);
 
 PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   VIRTUAL_WITH_TESTS void
@@ -209,6 +211,13 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   VIRTUAL_WITH_TESTS void
   cancelUnsatisfyAndStragglerTimer(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief update the route hash of Data about to be sent,
+   *         copying the data if it's still shared
+   *  \return the data to send
+   */
+  shared_ptr<const Data>
+  updateOutgoingRoute(fw::OutgoingData& data);
+
   /** \brief insert Nonce to Dead Nonce List if necessary
    *  \param upstream if null, insert Nonces from all OutRecords;
    *                  if not null, insert Nonce only on the OutRecord of this face
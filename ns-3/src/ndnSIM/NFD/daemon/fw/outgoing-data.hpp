@@ -0,0 +1,95 @@
+/**
+* @class nfd::fw::OutgoingData
+* @brief Copy on write handle to Data being sent to a downstream
+*
+* The handle starts out sharing the Data it's given, along with its
+* wire encoding.  A private copy is only made the first time the data
+* is modified through modify(), so data that's forwarded unchanged
+* doesn't need to be copied or re-encoded.
+*
+* Copying a handle shares the data it refers to, but never its
+* ownership; the copy makes its own private copy when modified.
+*
+* @note This file is not a part of the original NFD library,
+*       it was added to accomodate the needs of a specific
+*       simulation.
+* @author Ray Stubbs [stubbs.ray@gmail.com]
+**/
+
+#ifndef NFD_DAEMON_FW_OUTGOING_DATA_HPP
+#define NFD_DAEMON_FW_OUTGOING_DATA_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+namespace fw {
+
+class OutgoingData
+{
+public:
+  explicit
+  OutgoingData(shared_ptr<const Data> data)
+    : m_data(data)
+  {
+  }
+
+  OutgoingData(const OutgoingData& other)
+    : m_data(other.m_data)
+  {
+  }
+
+  OutgoingData&
+  operator=(const OutgoingData& other)
+  {
+    m_data = other.m_data;
+    m_copy.reset();
+    return *this;
+  }
+
+  /** \return the data to be sent, for reading
+   */
+  const Data&
+  get() const
+  {
+    return *m_data;
+  }
+
+  /** \return the data to be sent, for modification; the data is
+   *          copied first unless it's already owned by the handle
+   */
+  Data&
+  modify()
+  {
+    if (m_copy == nullptr) {
+      m_copy = make_shared<Data>(*m_data);
+      m_data = m_copy;
+    }
+    return *m_copy;
+  }
+
+  /** \return whether the data has been modified, and so no longer
+   *          shares the original
+   */
+  bool
+  isModified() const
+  {
+    return m_copy != nullptr;
+  }
+
+  /** \return the data to be sent
+   */
+  shared_ptr<const Data>
+  share() const
+  {
+    return m_data;
+  }
+
+private:
+  shared_ptr<const Data> m_data;
+  shared_ptr<Data> m_copy;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_OUTGOING_DATA_HPP
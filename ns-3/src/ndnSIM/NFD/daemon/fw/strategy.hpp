@@ -33,6 +33,7 @@
 #define NFD_DAEMON_FW_STRATEGY_HPP
 
 #include "forwarder.hpp"
+#include "outgoing-data.hpp"
 #include "strategy-registry.hpp"
 #include "table/measurements-accessor.hpp"
 
@@ -136,7 +137,8 @@ public: // triggers
   *
   * @param[in]      face         The face to forward the data to
   * @param[in]      interest     The interest that requested the data
-  * @param[in|out]  data         The data to be used to statisfy the request
+  * @param[in|out]  data         The data to be used to statisfy the request,
+  *                              only copied once modified through modify()
   * @param[in|out]  delay        The processing delay ( computational overhead ) to simulate
   *                              for the request
   * @return true if the request should be satisfied with data, false if the request
@@ -145,9 +147,47 @@ public: // triggers
   virtual bool
   filterOutgoingData( const Face&,
                       const Interest& interest,
-                      Data& data,
+                      OutgoingData& data,
                       ns3::Time& delay ){ return true; };
 
+  /**
+  * @brief A downstream that data is about to be sent to
+  **/
+  struct DataDownstream
+  {
+    Face&           face;
+    const Interest& interest;
+    OutgoingData    data;
+    ns3::Time       delay;
+    bool            send;
+  };
+
+  /**
+  * @brief Called before a pit entry is satisfied with all the
+  * downstreams that use this strategy, so that strategies can
+  * share work between downstreams; such as validating the same
+  * credentials only once.
+  *
+  * The default calls the single downstream filterOutgoingData()
+  * for each downstream.
+  *
+  * @note This is a mod by Ray Stubbs [stubbs.ray@gmail.com]
+  *       for use in a specific simulation.
+  *
+  * @param[in|out]  downstreams  The downstreams, for each the data, delay
+  *                              and whether the data should be sent are
+  *                              set as by filterOutgoingData()
+  **/
+  virtual void
+  filterOutgoingData( std::vector<DataDownstream>& downstreams )
+  {
+    for( DataDownstream& downstream : downstreams )
+      downstream.send = filterOutgoingData( downstream.face,
+                                            downstream.interest,
+                                            downstream.data,
+                                            downstream.delay );
+  };
+
   /**
   * @brief Called before an interest is forwarded to give the
   *        final forwarding decision to the strategy
@@ -5,9 +5,14 @@
 * between transmitions to simulate signature verification and queue
 * lookup delays.
 *
-* Events are always being scheduled and executed while the queue
-* is not empty, there is no functionality for starting or stopping
-* execution.
+* The queue keeps at most one simulator event scheduled.  When it
+* fires all operations up to the next delay are executed inline, and
+* the event is only re-armed for the end of that delay.  Operations
+* are never executed from within the call that queues them.
+*
+* The time each packet spent waiting behind the delays of earlier
+* packets, not counting the delay queued right before it, is reported
+* to queueingTrace, keyed by the nonce of its interest.
 *
 * @note This file is not a part of the original NFD library,
 *       it was added to accomodate the needs of a specific
@@ -22,33 +27,12 @@
 #include "ns3/core-module.h"
 #include "ndn-cxx/interest.hpp"
 #include "ndn-cxx/data.hpp"
-#include <boost/variant.hpp>
-#include <boost/tuple/tuple.hpp>
 #include <memory>
-#include <mutex>
+#include <queue>
 
 namespace ndntac
 {
   using namespace std;
-  
-  /* Events of each type and a general event */
-  typedef std::pair< shared_ptr< nfd::Face >,
-                     shared_ptr< const ndn::Interest > >  SendInterestEvent;
-  typedef std::pair< shared_ptr< nfd::Face >,
-                     shared_ptr< const ndn::Data > >      SendDataEvent;
-
- // we use tuple instead of pair on these next two to distinguish from the
- // above two types
- typedef std::tuple< shared_ptr< nfd::Face >,
-                     shared_ptr< const ndn::Interest > >  ReceiveInterestEvent;
- typedef std::tuple< shared_ptr< nfd::Face >,
-                     shared_ptr< const ndn::Data > >      ReceiveDataEvent;
-  typedef ns3::Time                                       DelayEvent;
-  typedef boost::variant< SendInterestEvent,
-                          SendDataEvent,
-                          ReceiveInterestEvent,
-                          ReceiveDataEvent,
-                          DelayEvent >                    TxEvent;
 
   class TxQueue
   {
@@ -63,137 +47,131 @@ namespace ndntac
       TxEvent_Delay
     };
 
+    /* a queued event, only the fields for its type are set */
+    struct TxEvent
+    {
+      TxEventType                       type;
+      shared_ptr< nfd::Face >           face;
+      shared_ptr< const ndn::Interest > interest;
+      shared_ptr< const ndn::Data >     data;
+      ns3::Time                         delay;
+
+      /* nonce of the interest the packet belongs to, -1 if unknown */
+      int64_t                           nonce;
+
+      /* time the event was queued */
+      ns3::Time                         queued;
+    };
+
     /* event queue */
     std::queue< TxEvent > m_queue;
-    ns3::EventId          m_last_event;
 
-    /* keeps track of wether an event is pending execution or not */
-    bool m_pending = false;
+    /* the one scheduled event, if any, which runs the queue */
+    ns3::EventId          m_event;
+
+    /* true while the queue is being run */
+    bool                  m_running = false;
+
+    /* the delay executed last, if the last event was one */
+    ns3::Time             m_last_delay;
 
     /* called to add an event of any type to the queue */
     void
-    addEvent( const TxEvent& event )
+    addEvent( TxEventType type,
+              shared_ptr< nfd::Face > face,
+              shared_ptr< const ndn::Interest > interest,
+              shared_ptr< const ndn::Data > data,
+              const ns3::Time& delay,
+              int64_t nonce = -1 )
     {
-      m_queue.push( event );
-      if( !m_pending )
-      {
-        m_pending = true;
-        doNext();
-      }
+      m_queue.push( TxEvent{ type, face, interest, data, delay,
+                             nonce, ns3::Simulator::Now() } );
+
+      // events queued while the queue is running or waiting
+      // out a delay are picked up by the current or scheduled run
+      if( !m_running && !m_event.IsRunning() )
+        m_event = ns3::Simulator::ScheduleNow( &TxQueue::run, this );
     }
 
-    /* called to execute the next event in the queue */
+    /* called to execute queued events until the next delay */
     void
-    doNext()
+    run()
     {
-      // if no events to execute then don't
-      if( m_queue.size() == 0 )
-      {
-        m_pending = false;
-        return;
-      }
-
-      // if an event is already running then reschedule to later time
-      if( m_last_event.IsRunning() )
+      m_running = true;
+      while( !m_queue.empty() )
       {
-        ns3::Simulator::Schedule( ns3::MilliSeconds( 1 ),
-                                  &TxQueue::doNext,
-                                  this );
-        return;
-      }
+        // events executed here may queue more events, so the
+        // front is moved out before executing it
+        TxEvent event = std::move( m_queue.front() );
+        m_queue.pop();
 
-      // otherwise schedule all events sequentially
-      const TxEvent& event = m_queue.front();
-      switch( event.which() )
-      {
-        case 0:
+        if( event.type != TxEvent_Delay )
         {
-          // schedule send interest then schedule next event immediately
-          const SendInterestEvent& send_event = boost::get<SendInterestEvent>(event);
-          m_last_event = ns3::Simulator::Schedule( ns3::Seconds( 0.0 ),
-                                                  &TxQueue::doSendInterest,
-                                                  this,
-                                                  send_event.first,
-                                                  send_event.second );
-          break;
+          traceQueueing( event );
+          m_last_delay = ns3::Time();
         }
-        case 1:
-        {
-          // schedule send interest then schedule next event immediately
-          const SendDataEvent& send_event = boost::get<SendDataEvent>(event);
-          m_last_event = ns3::Simulator::Schedule( ns3::Seconds( 0.0 ),
-                                                  &TxQueue::doSendData,
-                                                  this,
-                                                  send_event.first,
-                                                  send_event.second );
-          break;
-        }
-        case 2:
-        {
-          // schedule receive interest then schedule next event immediately
-          const ReceiveInterestEvent& receive_event = boost::get<ReceiveInterestEvent>(event);
-          m_last_event = ns3::Simulator::Schedule( ns3::Seconds( 0.0 ),
-                                                  &TxQueue::doReceiveInterest,
-                                                  this,
-                                                  std::get<0>(receive_event),
-                                                  std::get<1>(receive_event ) );
-          break;
-        }
-        case 3:
-        {
-          // schedule receive data then schedule next event immediately
-          const ReceiveDataEvent& receive_event = boost::get<ReceiveDataEvent>(event);
-          m_last_event = ns3::Simulator::Schedule( ns3::Seconds( 0.0 ),
-                                                  &TxQueue::doReceiveData,
-                                                  this,
-                                                  std::get<0>(receive_event),
-                                                  std::get<1>(receive_event ) );
-          break;
-        }
-      case 4:
-          // schedule next event after specified delay
-          const DelayEvent& delay_event = boost::get<DelayEvent>( event );
-          m_last_event = ns3::Simulator::Schedule( delay_event,
-                                                    &TxQueue::doNext,
-                                                    this );
-          break;
-      };
 
-      m_queue.pop();
+        switch( event.type )
+        {
+          case TxEvent_SendInterest:
+            event.face->sendInterest( *event.interest );
+            break;
+          case TxEvent_SendData:
+            event.face->sendData( *event.data );
+            break;
+          case TxEvent_ReceiveInterest:
+            event.face->emit_onReceiveInterest( *event.interest );
+            break;
+          case TxEvent_ReceiveData:
+            event.face->emit_onReceiveData( *event.data );
+            break;
+          case TxEvent_Delay:
+            m_last_delay = event.delay;
+
+            // continue after the delay, zero delays are skipped
+            if( event.delay.IsStrictlyPositive() )
+            {
+              m_event = ns3::Simulator::Schedule( event.delay,
+                                                  &TxQueue::run,
+                                                  this );
+              m_running = false;
+              return;
+            }
+            break;
+        };
+      }
+      m_running = false;
     };
 
+    /* reports the time an event waited behind other packets */
     void
-    doSendData( shared_ptr< nfd::Face > face,
-                shared_ptr< const ndn::Data > data )
+    traceQueueing( const TxEvent& event )
     {
-      face->sendData( *data );
-      doNext();
-    }
+      int64_t nonce = event.nonce;
+      if( event.interest )
+        nonce = event.interest->getNonce();
+      if( nonce < 0 )
+        return;
 
-    void
-    doSendInterest( shared_ptr< nfd::Face > face,
-                    shared_ptr< const ndn::Interest > interest)
-    {
-      face->sendInterest( *interest );
-      doNext();
+      // the packet's own delay is processing, not queueing
+      ns3::Time queueing = ns3::Simulator::Now() - event.queued
+                         - m_last_delay;
+      if( queueing.IsStrictlyPositive() )
+        queueingTrace()( (uint32_t)nonce, queueing );
     }
 
-    void
-    doReceiveData( shared_ptr< nfd::Face > face,
-                shared_ptr< const ndn::Data > data )
+  public:
+    /**
+    * @brief Trace of the time packets spent queued behind the
+    *        delays of other packets, shared by all queues
+    **/
+    static ns3::TracedCallback< uint32_t /*nonce*/, ns3::Time /*queueing*/ >&
+    queueingTrace()
     {
-      face->emit_onReceiveData( *data );
-      doNext();
+      static ns3::TracedCallback< uint32_t, ns3::Time > trace;
+      return trace;
     }
 
-    void
-    doReceiveInterest( shared_ptr< nfd::Face > face,
-                    shared_ptr< const ndn::Interest > interest)
-    {
-      face->emit_onReceiveInterest( *interest );
-      doNext();
-    }
-  public:
     /**
     * @brief Queue an interest to be sent to the given face
     * @param face      Face to send interest to
@@ -203,19 +181,21 @@ namespace ndntac
     sendInterest( shared_ptr< nfd::Face > face,
                   shared_ptr<const ndn::Interest> interest )
     {
-      addEvent( make_pair( face, interest ) );
+      addEvent( TxEvent_SendInterest, face, interest, nullptr, ns3::Time() );
     }
 
     /**
     * @brief Queue a Data to be sent to the given face
     * @param face     Face to send data to
     * @param data     Data to send
+    * @param nonce    Nonce of the interest the data is for, if known
     **/
     void
     sendData( shared_ptr< nfd::Face > face,
-              shared_ptr< const ndn::Data > data )
+              shared_ptr< const ndn::Data > data,
+              int64_t nonce = -1 )
     {
-      addEvent( make_pair( face, data ) );
+      addEvent( TxEvent_SendData, face, nullptr, data, ns3::Time(), nonce );
     }
 
     /**
@@ -227,19 +207,21 @@ namespace ndntac
     receiveInterest( shared_ptr< nfd::Face > face,
                      shared_ptr<const ndn::Interest> interest )
     {
-      addEvent( make_tuple( face, interest ) );
+      addEvent( TxEvent_ReceiveInterest, face, interest, nullptr, ns3::Time() );
     }
 
     /**
     * @brief Queue an emission of onReceiveData event
     * @param face     Face receive data
     * @param data     Data to receive
+    * @param nonce    Nonce of the interest the data is for, if known
     **/
     void
     receiveData( shared_ptr< nfd::Face > face,
-                 shared_ptr< const ndn::Data > data )
+                 shared_ptr< const ndn::Data > data,
+                 int64_t nonce = -1 )
     {
-      addEvent( make_tuple( face, data ) );
+      addEvent( TxEvent_ReceiveData, face, nullptr, data, ns3::Time(), nonce );
     }
 
     /**
@@ -249,7 +231,9 @@ namespace ndntac
     void
     delay( const ns3::Time& delay )
     {
-      addEvent( delay );
+      // a delay at the end of the queue is still waited out
+      // before any events queued after it
+      addEvent( TxEvent_Delay, nullptr, nullptr, nullptr, delay );
     }
   };
 
@@ -70,45 +70,25 @@ public:
 
 typedef boost::mpl::if_c<sizeof(size_t) >= 8, Hash64, Hash32>::type CityHash;
 
+static size_t
+hashComponent(const uint8_t* wire, size_t size)
+{
+  return CityHash::compute(reinterpret_cast<const char*>(wire), size);
+}
+
 // Interface of different hash functions
 size_t
 computeHash(const Name& prefix)
 {
-  prefix.wireEncode();  // guarantees prefix's wire buffer is not empty
-
-  size_t hashValue = 0;
-  size_t hashUpdate = 0;
-
-  for (Name::const_iterator it = prefix.begin(); it != prefix.end(); it++)
-    {
-      const char* wireFormat = reinterpret_cast<const char*>( it->wire() );
-      hashUpdate = CityHash::compute(wireFormat, it->size());
-      hashValue ^= hashUpdate;
-    }
-
-  return hashValue;
+  return prefix.getPrefixHashes(&hashComponent).back();
 }
 
-std::vector<size_t>
+const std::vector<size_t>&
 computeHashSet(const Name& prefix)
 {
-  prefix.wireEncode();  // guarantees prefix's wire buffer is not empty
-
-  size_t hashValue = 0;
-  size_t hashUpdate = 0;
-
-  std::vector<size_t> hashValueSet;
-  hashValueSet.push_back(hashValue);
-
-  for (Name::const_iterator it = prefix.begin(); it != prefix.end(); it++)
-    {
-      const char* wireFormat = reinterpret_cast<const char*>( it->wire() );
-      hashUpdate = CityHash::compute(wireFormat, it->size());
-      hashValue ^= hashUpdate;
-      hashValueSet.push_back(hashValue);
-    }
-
-  return hashValueSet;
+  // the hashes are memoized by the name, so the same name
+  // isn't hashed again by every table it's looked up in
+  return prefix.getPrefixHashes(&hashComponent);
 }
 
 } // namespace name_tree
@@ -150,11 +130,10 @@ NameTree::~NameTree()
 
 // insert() is a private function, and called by only lookup()
 std::pair<shared_ptr<name_tree::Entry>, bool>
-NameTree::insert(const Name& prefix)
+NameTree::insert(const Name& prefix, size_t hashValue)
 {
   NFD_LOG_TRACE("insert " << prefix);
 
-  size_t hashValue = name_tree::computeHash(prefix);
   size_t loc = hashValue % m_nBuckets;
 
   NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue << "  location = " << loc);
@@ -209,12 +188,14 @@ NameTree::lookup(const Name& prefix)
   shared_ptr<name_tree::Entry> entry;
   shared_ptr<name_tree::Entry> parent;
 
+  const std::vector<size_t>& hashValueSet = name_tree::computeHashSet(prefix);
+
   for (size_t i = 0; i <= prefix.size(); i++)
     {
       Name temp = prefix.getPrefix(i);
 
       // insert() will create the entry if it does not exist.
-      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(temp);
+      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(temp, hashValueSet[i]);
       entry = ret.first;
 
       if (ret.second == true)
@@ -277,7 +258,7 @@ NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelec
   NFD_LOG_TRACE("findLongestPrefixMatch " << prefix);
 
   shared_ptr<name_tree::Entry> entry;
-  std::vector<size_t> hashValueSet = name_tree::computeHashSet(prefix);
+  const std::vector<size_t>& hashValueSet = name_tree::computeHashSet(prefix);
 
   size_t hashValue = 0;
   size_t loc = 0;
@@ -40,9 +40,11 @@ computeHash(const Name& prefix);
 
 /**
  * \brief Incrementally compute hash values
- * \return Return a vector of hash values, starting from the root prefix
+ * \return Return a vector of hash values, starting from the root prefix;
+ *         the hashes are memoized by the name, and the reference is valid
+ *         until the name is modified
  */
-std::vector<size_t>
+const std::vector<size_t>&
 computeHashSet(const Name& prefix);
 
 /// a predicate to accept or reject an Entry in find operations
@@ -325,7 +327,7 @@ private:
    * entry (true).
    */
   std::pair<shared_ptr<name_tree::Entry>, bool>
-  insert(const Name& prefix);
+  insert(const Name& prefix, size_t hashValue);
 };
 
 inline NameTree::const_iterator::~const_iterator()
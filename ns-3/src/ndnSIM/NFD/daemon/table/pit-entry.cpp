@@ -142,8 +142,7 @@ Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
     
     // otherwise create a new InRecord for the interest
     if (it == m_inRecords.end()) {
-      m_inRecords.emplace_front(face);
-      it = m_inRecords.begin();
+      it = m_inRecords.emplace(m_inRecords.begin(), face);
     }
     it->update(interest);
     return it;
@@ -164,14 +163,23 @@ Entry::deleteInRecords()
   m_inRecords.clear();
 }
 
+void
+Entry::moveInRecords(InRecordCollection& records)
+{
+  // only works for top level entry
+  for (InRecord& inRecord : m_inRecords) {
+    records.push_back(std::move(inRecord));
+  }
+  m_inRecords.clear();
+}
+
 OutRecordCollection::iterator
 Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
 {
     auto it = std::find_if(m_outRecords.begin(), m_outRecords.end(),
       [&face] (const OutRecord& outRecord) { return outRecord.getFace() == face; });
     if (it == m_outRecords.end()) {
-      m_outRecords.emplace_front(face);
-      it = m_outRecords.begin();
+      it = m_outRecords.emplace(m_outRecords.begin(), face);
     }
 
     it->update(interest);
@@ -30,6 +30,8 @@
 #include "pit-out-record.hpp"
 #include "core/scheduler.hpp"
 
+#include <boost/container/small_vector.hpp>
+
 namespace nfd {
 
 class NameTree;
@@ -41,12 +43,18 @@ class Entry;
 namespace pit {
 
 /** \brief represents an unordered collection of InRecords
+ *
+ *  Entries rarely have records for more than a few faces, so the
+ *  first records are stored inline.  Inserting or deleting records
+ *  invalidates iterators to the collection.
  */
-typedef std::list< InRecord>  InRecordCollection;
+typedef boost::container::small_vector<InRecord, 4> InRecordCollection;
 
 /** \brief represents an unordered collection of OutRecords
+ *
+ *  Stored like InRecordCollection.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef boost::container::small_vector<OutRecord, 4> OutRecordCollection;
 
 /** \brief indicates where duplicate Nonces are found
  */
@@ -142,6 +150,11 @@ public: // InRecord
   void
   deleteInRecords();
 
+  /** \brief deletes all InRecords, moving them into records
+   */
+  void
+  moveInRecords(InRecordCollection& records);
+
 public: // OutRecord
   const OutRecordCollection&
   getOutRecords() const;
@@ -53,6 +53,9 @@
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 
 #include <unordered_map>
+#include <atomic>
+#include <queue>
+#include <thread>
 
 #include "boost-graph-ndn-global-routing-helper.hpp"
 
@@ -386,5 +389,171 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes()
   }
 }
 
+namespace {
+
+/**
+ * @brief Topology flattened into compressed sparse rows, so shortest path searches on
+ *        different threads only read plain arrays and never touch ns-3 objects
+ */
+struct CompactGraph {
+  static const uint32_t NO_EDGE = std::numeric_limits<uint32_t>::max();
+
+  std::vector<Ptr<GlobalRouter>> routers;
+  std::vector<bool> isOrigin;
+  size_t nOrigins = 0;
+
+  // out edges of router i are edges [offsets[i], offsets[i + 1])
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> targets;
+  std::vector<uint16_t> metrics;
+  std::vector<shared_ptr<Face>> faces;
+};
+
+/**
+ * @brief Shortest path distance and first hop from one router to another
+ */
+struct Route {
+  uint32_t metric;
+  uint32_t firstEdge;
+};
+
+void
+buildCompactGraph(CompactGraph& graph)
+{
+  std::unordered_map<uint32_t, uint32_t> indices;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> router = (*node)->GetObject<GlobalRouter>();
+    if (router == 0) {
+      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+      continue;
+    }
+    indices[router->GetId()] = graph.routers.size();
+    graph.routers.push_back(router);
+
+    bool isOrigin = !router->GetLocalPrefixes().empty();
+    graph.isOrigin.push_back(isOrigin);
+    graph.nOrigins += isOrigin;
+  }
+
+  graph.offsets.reserve(graph.routers.size() + 1);
+  for (const auto& router : graph.routers) {
+    graph.offsets.push_back(graph.targets.size());
+    for (const auto& incidency : router->GetIncidencies()) {
+      auto target = indices.find(std::get<2>(incidency)->GetId());
+      if (target == indices.end())
+        continue;
+
+      // same weights as boost::EdgeWeights
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      graph.targets.push_back(target->second);
+      graph.metrics.push_back(face == nullptr ? 0 : static_cast<uint16_t>(face->getMetric()));
+      graph.faces.push_back(face);
+    }
+  }
+  graph.offsets.push_back(graph.targets.size());
+}
+
+/**
+ * @brief Dijkstra from one router, until all origins have been reached
+ *
+ * Distances are relaxed the same way as with dijkstra_shortest_paths in CalculateRoutes: a
+ * path only replaces another if it's strictly shorter, and the first hop is the first edge
+ * of the path that has a face.
+ */
+void
+calculateShortestPaths(const CompactGraph& graph, uint32_t source, std::vector<Route>& routes)
+{
+  typedef std::pair<uint32_t, uint32_t> QueueEntry; // metric, router
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+  std::vector<bool> settled(graph.routers.size(), false);
+
+  routes.assign(graph.routers.size(),
+                Route{std::numeric_limits<uint16_t>::max(), CompactGraph::NO_EDGE});
+  routes[source] = Route{0, CompactGraph::NO_EDGE};
+  queue.push(QueueEntry(0, source));
+
+  size_t originsLeft = graph.nOrigins;
+  while (!queue.empty() && originsLeft > 0) {
+    uint32_t u = queue.top().second;
+    queue.pop();
+    if (settled[u])
+      continue;
+    settled[u] = true;
+    if (graph.isOrigin[u])
+      originsLeft--;
+
+    for (uint32_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      uint32_t v = graph.targets[e];
+      uint32_t metric = routes[u].metric + graph.metrics[e];
+      if (settled[v] || metric >= routes[v].metric)
+        continue;
+
+      // edges without a face don't count as the first hop
+      uint32_t firstEdge = routes[u].firstEdge;
+      if (firstEdge == CompactGraph::NO_EDGE || graph.faces[firstEdge] == nullptr)
+        firstEdge = e;
+
+      routes[v].metric = metric;
+      routes[v].firstEdge = firstEdge;
+      queue.push(QueueEntry(metric, v));
+    }
+  }
+}
+
+} // namespace
+
+void
+GlobalRoutingHelper::CalculateRoutesInParallel(uint32_t nThreads)
+{
+  CompactGraph graph;
+  buildCompactGraph(graph);
+
+  if (nThreads == 0)
+    nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  nThreads = std::min<size_t>(nThreads, std::max<size_t>(graph.routers.size(), 1));
+
+  // only the routes to origins are kept, as (origin, route) pairs
+  std::vector<std::vector<std::pair<uint32_t, Route>>> results(graph.routers.size());
+
+  std::atomic<uint32_t> nextSource(0);
+  auto worker = [&] {
+    std::vector<Route> routes;
+    for (uint32_t source = nextSource++; source < graph.routers.size(); source = nextSource++) {
+      calculateShortestPaths(graph, source, routes);
+      for (uint32_t origin = 0; origin < graph.routers.size(); origin++) {
+        if (origin != source && graph.isOrigin[origin]
+            && routes[origin].firstEdge != CompactGraph::NO_EDGE)
+          results[source].push_back(std::make_pair(origin, routes[origin]));
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < nThreads; i++)
+    threads.push_back(std::thread(worker));
+  worker();
+  for (auto& thread : threads)
+    thread.join();
+
+  // ns-3 objects are only touched from this thread
+  for (uint32_t source = 0; source < graph.routers.size(); source++) {
+    Ptr<Node> node = graph.routers[source]->GetObject<Node>();
+    NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
+
+    for (const auto& result : results[source]) {
+      const shared_ptr<Face>& face = graph.faces[result.second.firstEdge];
+      if (face == nullptr)
+        continue; // unreachable, as in CalculateRoutes
+
+      for (const auto& prefix : graph.routers[result.first]->GetLocalPrefixes()) {
+        NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << *face
+                     << " with distance " << result.second.metric);
+
+        FibHelper::AddRoute(node, *prefix, face, result.second.metric);
+      }
+    }
+  }
+}
+
 } // namespace ndn
 } // namespace ns3
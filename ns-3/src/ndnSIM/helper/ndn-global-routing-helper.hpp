@@ -111,6 +111,26 @@ public:
   static void
   CalculateAllPossibleRoutes();
 
+  /**
+   * @brief Calculate the same routes as CalculateRoutes, in parallel
+   *
+   * The topology is flattened into a compact adjacency array once, and the shortest path
+   * trees of the nodes are computed on a pool of threads.  Each search stops as soon as
+   * every node with origin prefixes has been reached, since only routes to those prefixes
+   * are installed.  Routes are installed on the calling thread, in node order.
+   *
+   * The routes have the same costs as those of CalculateRoutes, but when several paths to an
+   * origin are equally short the chosen next hop may differ, since ties are broken by the
+   * order of the compact arrays rather than by boost's d-ary heap.  Every route is
+   * recalculated on each call; there is no incremental update after topology changes.
+   *
+   * The topology must not be changed while routes are calculated.
+   *
+   * @param nThreads Number of threads to use, 0 to use one per hardware thread
+   */
+  static void
+  CalculateRoutesInParallel(uint32_t nThreads = 0);
+
 private:
   void
   Install(Ptr<Channel> channel);
@@ -20,10 +20,6 @@
 #include "ndn-header.hpp"
 
 #include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
-namespace io = boost::iostreams;
 
 namespace ns3 {
 namespace ndn {
@@ -84,44 +80,70 @@ template<class Pkt>
 void
 PacketHeader<Pkt>::Serialize(ns3::Buffer::Iterator start) const
 {
-  start.Write(m_packet->wireEncode().wire(), m_packet->wireEncode().size());
+  const ::ndn::Block& wire = m_packet->wireEncode();
+  start.Write(wire.wire(), wire.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/**
+ * @brief Read a TLV VAR-NUMBER from the buffer
+ * @return the number of bytes read
+ */
+static uint32_t
+readVarNumber(ns3::Buffer::Iterator& i, uint64_t& number)
+{
+  if (i.IsEnd())
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV processing"));
+
+  uint8_t first = i.ReadU8();
+  uint32_t length = 1;
+  switch (first) {
+  case 253:
+    length = 3;
+    break;
+  case 254:
+    length = 5;
+    break;
+  case 255:
+    length = 9;
+    break;
+  default:
+    number = first;
+    return 1;
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  number = 0;
+  for (uint32_t n = 1; n < length; ++n) {
+    if (i.IsEnd())
+      BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV processing"));
+    number = (number << 8) | i.ReadU8();
   }
-
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  return length;
+}
 
 template<class Pkt>
 uint32_t
 PacketHeader<Pkt>::Deserialize(ns3::Buffer::Iterator start)
 {
+  // peek the TLV type and length to find the size of the packet,
+  // then copy it out of the ns-3 buffer in one go; headers are
+  // always deserialized from the start of the packet's buffer, so
+  // the buffer's size is what's left to read
+  ns3::Buffer::Iterator peek = start;
+  uint64_t type;
+  uint64_t length;
+  uint64_t size = readVarNumber(peek, type);
+  size += readVarNumber(peek, length);
+  size += length;
+  if (size > start.GetSize())
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV"));
+
+  auto buffer = make_shared<::ndn::Buffer>(size);
+  start.Read(buffer->buf(), size);
+
   auto packet = make_shared<Pkt>();
-  io::stream<Ns3BufferIteratorSource> is(start);
-  packet->wireDecode(::ndn::Block::fromStream(is));
+  packet->wireDecode(::ndn::Block(buffer));
   m_packet = packet;
-  return packet->wireEncode().size();
+  return size;
 }
 
 template<>
@@ -6,6 +6,104 @@
 
 namespace ndn
 {
+    namespace
+    {
+        inline uint64_t rotl64( uint64_t x, int8_t r )
+        {
+            return ( x << r ) | ( x >> ( 64 - r ) );
+        }
+
+        // MurmurHash3 finalization mix
+        inline uint64_t fmix64( uint64_t k )
+        {
+            k ^= k >> 33;
+            k *= 0xff51afd7ed558ccdULL;
+            k ^= k >> 33;
+            k *= 0xc4ceb9fe1a85ec53ULL;
+            k ^= k >> 33;
+            return k;
+        }
+
+        /**
+        * Streaming two lane hash based on the MurmurHash3 x64_128
+        * mixing function.  Fields are fed one at a time so the
+        * tag never has to be encoded as a whole.
+        **/
+        class FingerprintHasher
+        {
+        public:
+            void update( uint64_t word )
+            {
+                static const uint64_t c1 = 0x87c37b91114253d5ULL;
+                static const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+                uint64_t k1 = word * c1;
+                k1 = rotl64( k1, 31 );
+                k1 *= c2;
+                m_h1 ^= k1;
+                m_h1 = rotl64( m_h1, 27 );
+                m_h1 += m_h2;
+                m_h1 = m_h1*5 + 0x52dce729;
+
+                uint64_t k2 = word * c2;
+                k2 = rotl64( k2, 33 );
+                k2 *= c1;
+                m_h2 ^= k2;
+                m_h2 = rotl64( m_h2, 31 );
+                m_h2 += m_h1;
+                m_h2 = m_h2*5 + 0x38495ab5;
+
+                m_length += sizeof( word );
+            }
+
+            void update( const uint8_t* data, size_t size )
+            {
+                // the size is mixed in first so that adjacent
+                // fields can't be shifted into one another
+                update( (uint64_t)size );
+
+                uint64_t word;
+                while( size >= sizeof( word ) )
+                {
+                    std::memcpy( &word, data, sizeof( word ) );
+                    update( word );
+                    data += sizeof( word );
+                    size -= sizeof( word );
+                }
+                if( size > 0 )
+                {
+                    word = 0;
+                    std::memcpy( &word, data, size );
+                    update( word );
+                }
+            }
+
+            void update( const Block& block )
+            {
+                update( block.wire(), block.size() );
+            }
+
+            void finalize( uint64_t* out )
+            {
+                uint64_t h1 = m_h1 ^ m_length;
+                uint64_t h2 = m_h2 ^ m_length;
+                h1 += h2;
+                h2 += h1;
+                h1 = fmix64( h1 );
+                h2 = fmix64( h2 );
+                h1 += h2;
+                h2 += h1;
+                out[0] = h1;
+                out[1] = h2;
+            }
+
+        private:
+            uint64_t m_h1 = 0x9e3779b97f4a7c15ULL;
+            uint64_t m_h2 = 0xc2b2ae3d27d4eb4fULL;
+            uint64_t m_length = 0;
+        };
+    }
+
     AuthTag::AuthTag( const Block& wire )
     {
         wireDecode( wire );
@@ -93,6 +191,7 @@ namespace ndn
 
     void AuthTag::wireDecode( const Block& wire )
     {
+        m_has_fingerprint = false;
         m_wire = wire;
         m_wire.parse();
 
@@ -129,8 +228,50 @@ namespace ndn
                                 m_wire.get( tlv::SignatureValue ) );
     };
 
+    size_t AuthTag::wireSize() const
+    {
+        if( m_wire.hasWire() )
+            return m_wire.size();
+
+        EncodingEstimator estimator;
+        return wireEncode( estimator );
+    };
+
     bool AuthTag::hasWire()
     {
         return m_wire.hasWire();
     };
+
+    const uint64_t* AuthTag::getFingerprint() const
+    {
+        if( m_has_fingerprint )
+            return m_fingerprint;
+
+        // all of the sub-blocks hashed here cache their own
+        // encodings, so they're only encoded if the tag was
+        // built locally and never encoded
+        FingerprintHasher hasher;
+
+        // Name -- Producer's prefix
+        hasher.update( (uint64_t)m_prefix.size() );
+        for( const name::Component& component : m_prefix )
+            hasher.update( component.value(), component.value_size() );
+
+        // AccessLevel and RouteHash
+        hasher.update( (uint64_t)m_access_level );
+        hasher.update( m_route_hash );
+
+        // KeyLocator -- Consumer Locator
+        hasher.update( m_consumer_locator.wireEncode() );
+
+        // SignatureInfo, includes validity period and key locator
+        hasher.update( m_signature.getInfo() );
+
+        // SignatureValue
+        hasher.update( m_signature.getValue() );
+
+        hasher.finalize( m_fingerprint );
+        m_has_fingerprint = true;
+        return m_fingerprint;
+    };
 }
@@ -26,6 +26,8 @@ namespace ndn
     {
         private:
             mutable Block m_wire;
+            mutable bool  m_has_fingerprint = false;
+            mutable uint64_t m_fingerprint[2];
             Name          m_prefix;
             uint8_t       m_access_level;
             uint64_t      m_route_hash;
@@ -35,6 +37,7 @@ namespace ndn
             void onChanged()
             {
                 m_wire.reset();
+                m_has_fingerprint = false;
             }
         public:
             class Error : public tlv::Error
@@ -52,9 +55,26 @@ namespace ndn
             template<encoding::Tag TAG>
             size_t wireEncode( EncodingImpl< TAG > &encoder ) const;
             const Block& wireEncode() const;
+
+            /**
+            * @brief Get the size of the wire format, estimated
+            *        without encoding if the tag has no wire
+            **/
+            size_t wireSize() const;
             void wireDecode( const Block& wire );
             bool hasWire();
 
+            /**
+            * @brief Get a 128-bit fingerprint of the tag
+            *
+            * The fingerprint is computed from the tag's fields with
+            * a fast non-cryptographic hash, so it doesn't require the
+            * tag to be encoded.  It's computed once and cached until
+            * the tag is modified.  Returns a pointer to two 64-bit
+            * words, suitable for double hashing.
+            **/
+            const uint64_t* getFingerprint() const;
+
             const Name& getPrefix() const
             {
               return m_prefix;
@@ -62,6 +82,7 @@ namespace ndn
 
             void setPrefix( const Name& prefix )
             {
+              onChanged();
               m_prefix = prefix;
             };
 
@@ -83,6 +104,7 @@ namespace ndn
 
             void setRouteHash( uint64_t hash )
             {
+              onChanged();
               m_route_hash = hash;
             }
 
@@ -93,6 +115,7 @@ namespace ndn
 
             void setConsumerLocator( const KeyLocator& locator )
             {
+              onChanged();
               m_consumer_locator = locator;
             }
 
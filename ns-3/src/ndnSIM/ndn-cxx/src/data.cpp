@@ -84,6 +84,10 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool only_signed_portion/* = false*
       {
           totalLength += encoder.prependBlock( m_route_tracker->wireEncode() );
       }
+      else if( m_route_tracker_wire.hasWire() )
+      {
+          totalLength += encoder.prependBlock( m_route_tracker_wire );
+      }
 
       // NoReCacheFlag
       if( m_no_recache_flag )
@@ -147,8 +151,11 @@ Data::wireEncode(EncodingBuffer& encoder, const Block& signatureValue) const
   totalLength += encoder.appendBlock(signatureValue);
   if( m_no_recache_flag )
     totalLength += encoder.appendBlock( Block( tlv::NoReCacheFlag) );
-  totalLength += encoder
-                 .appendBlock( m_route_tracker->wireEncode() );
+  if( m_route_tracker )
+    totalLength += encoder
+                   .appendBlock( m_route_tracker->wireEncode() );
+  else if( m_route_tracker_wire.hasWire() )
+    totalLength += encoder.appendBlock( m_route_tracker_wire );
 
   encoder.prependVarNumber(totalLength);
   encoder.prependVarNumber(tlv::Data);
@@ -173,6 +180,16 @@ Data::wireEncode() const
   return m_wire;
 }
 
+size_t
+Data::wireSize() const
+{
+  if (m_wire.hasWire())
+    return m_wire.size();
+
+  EncodingEstimator estimator;
+  return wireEncode(estimator);
+}
+
 void
 Data::wireDecode(const Block& wire)
 {
@@ -226,10 +243,23 @@ Data::wireDecode(const Block& wire)
   if( val != m_wire.elements_end() )
     m_no_recache_flag = true;
 
-  // RouteTracker
+  // RouteTracker, decoded on first access
+  m_route_tracker.reset();
   val = m_wire.find( tlv::RouteTracker );
   if( val != m_wire.elements_end() )
-    m_route_tracker.reset( new RouteTracker( *val ) );
+    m_route_tracker_wire = *val;
+  else
+    m_route_tracker_wire.reset();
+}
+
+RouteTracker*
+Data::decodeRouteTracker() const
+{
+  if (!m_route_tracker && m_route_tracker_wire.hasWire()) {
+    m_route_tracker.reset(new RouteTracker(m_route_tracker_wire));
+    m_route_tracker_wire.reset();
+  }
+  return m_route_tracker.get();
 }
 
 Data&
@@ -389,6 +419,22 @@ Data::onChanged()
   m_fullName.clear();
 }
 
+void
+Data::patchRouteTracker()
+{
+  Block wire = m_route_tracker->patchPacketWire(m_wire);
+  if (!wire.hasWire()) {
+    onChanged();
+    return;
+  }
+
+  // the implicit digest covers the route tracker too
+  m_fullName.clear();
+  m_wire = wire;
+  m_wire.parse();
+  m_route_tracker->wireDecode(m_wire.get(tlv::RouteTracker));
+}
+
 Data&
 Data::operator=( const Data& other )
 {
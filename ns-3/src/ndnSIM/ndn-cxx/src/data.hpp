@@ -117,6 +117,15 @@ public:
   const Block&
   wireEncode() const;
 
+  /**
+   * @brief Get the size of the wire format
+   *
+   * If the Data has no wire, the size is estimated with
+   * EncodingEstimator instead of encoding it.
+   */
+  size_t
+  wireSize() const;
+
   /**
    * @brief Finalize Data packet encoding with the specified SignatureValue
    *
@@ -318,7 +327,8 @@ public:
   setNoReCacheFlag( bool flag );
 
   /**
-  * @brief Get the route hash
+  * @brief Get the route tracker, it's decoded from the wire on
+  *        first access
   **/
   const RouteTracker&
   getRouteTracker() const;
@@ -398,6 +408,23 @@ protected:
   void
   onChanged();
 
+private:
+  /**
+   * @brief Write the updated RouteTracker fields into the wire
+   *        instead of clearing it, falls back to onChanged() if
+   *        the wire can't be patched
+   */
+  void
+  patchRouteTracker();
+
+  /**
+   * @brief Decode the RouteTracker from its wire element if that
+   *        hasn't been done yet
+   * @return the RouteTracker, or nullptr if the Data has none
+   */
+  RouteTracker*
+  decodeRouteTracker() const;
+
 private:
   Name m_name;
   MetaInfo m_metaInfo;
@@ -405,7 +432,10 @@ private:
   Signature m_signature;
   uint8_t   m_access_level = 0;
   bool      m_no_recache_flag = false;
-  unique_ptr<RouteTracker> m_route_tracker;
+  // the RouteTracker is kept as its wire element until it's
+  // first accessed, only one of the two is set
+  mutable unique_ptr<RouteTracker> m_route_tracker;
+  mutable Block m_route_tracker_wire;
 
   mutable Block m_wire;
   mutable Name m_fullName;
@@ -490,68 +520,74 @@ Data::setNoReCacheFlag( bool flag )
 inline const RouteTracker&
 Data::getRouteTracker() const
 {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    const RouteTracker* tracker = decodeRouteTracker();
+    if( !tracker ) BOOST_THROW_EXCEPTION(
        Error( "Requested route tracker does not exist" ) 
     );
-return *m_route_tracker;
+    return *tracker;
 }
 
 inline RouteTracker::NetworkType
 Data::getCurrentNetwork() const
 {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    const RouteTracker* tracker = decodeRouteTracker();
+    if( !tracker ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to get network of data without route tracker" ) 
     );
-    return m_route_tracker->getCurrentNetwork();
+    return tracker->getCurrentNetwork();
 }
 
 inline void
 Data::setCurrentNetwork( RouteTracker::NetworkType type )
 {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    if( !decodeRouteTracker() ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to set network of data without route tracker" ) 
     );
     m_route_tracker->setCurrentNetwork( type );
-    m_wire.reset();
+    patchRouteTracker();
 }
 
 inline bool
 Data::hasRouteTracker() const
 {
-    return m_route_tracker != NULL;
+    return m_route_tracker != NULL || m_route_tracker_wire.hasWire();
 }
 
 inline uint64_t
 Data::getEntryRoute() const
 {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    const RouteTracker* tracker = decodeRouteTracker();
+    if( !tracker ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to get route of data without route tracker" ) 
     );
-    return m_route_tracker->getEntryRoute();
+    return tracker->getEntryRoute();
 }
 
 inline uint64_t
 Data::getInternetRoute() const
 {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    const RouteTracker* tracker = decodeRouteTracker();
+    if( !tracker ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to get route of data without route tracker" ) 
     );
-    return m_route_tracker->getInternetRoute();
+    return tracker->getInternetRoute();
 }
 
 inline uint64_t
 Data::getExitRoute() const
 {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    const RouteTracker* tracker = decodeRouteTracker();
+    if( !tracker ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to get route of data without route tracker" ) 
     );
-    return m_route_tracker->getExitRoute();
+    return tracker->getExitRoute();
 }
 
 inline Data&
 Data::setRouteTracker( const RouteTracker& tracker )
 {
     m_route_tracker.reset( new RouteTracker( tracker ) );
+    m_route_tracker_wire.reset();
     m_wire.reset();
     return *this;
 }
@@ -559,11 +595,11 @@ Data::setRouteTracker( const RouteTracker& tracker )
 inline void
 Data::updateRoute( uint64_t link_id )
 {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    if( !decodeRouteTracker() ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to update route of data without route tracker" ) 
     );
     m_route_tracker->update( link_id );
-    m_wire.reset();
+    patchRouteTracker();
 }
 
 inline nfd::LocalControlHeader&
@@ -248,6 +248,8 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder, bool only_signed_portion ) cons
     // RouteTracker
     if( m_route_tracker )
         totalLength += m_route_tracker->wireEncode( encoder );
+    else if( m_route_tracker_wire.hasWire() )
+        totalLength += encoder.prependBlock( m_route_tracker_wire );
 
     // AuthValidityProbability
     if( m_auth_validity_prob > 0 )
@@ -269,6 +271,8 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder, bool only_signed_portion ) cons
   // AuthTag
   if( m_auth_tag )
     signed_length += m_auth_tag->wireEncode( encoder );
+  else if( m_auth_tag_wire.hasWire() )
+    signed_length += encoder.prependBlock( m_auth_tag_wire );
 
   // InterestLifetime
   if (getInterestLifetime() >= time::milliseconds::zero() &&
@@ -325,6 +329,8 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder, const Block& signatureValue ) c
   // RouteTracker
   if( m_route_tracker )
       totalLength += encoder.appendBlock( m_route_tracker->wireEncode() );
+  else if( m_route_tracker_wire.hasWire() )
+      totalLength += encoder.appendBlock( m_route_tracker_wire );
 
   encoder.prependVarNumber(totalLength);
   encoder.prependVarNumber(tlv::Interest);
@@ -351,12 +357,31 @@ Interest::wireEncode() const
   EncodingBuffer buffer(estimatedSize, 0);
   wireEncode(buffer);
 
+  // the AuthTag was just encoded from the decoded one, so it's kept
+  // rather than decoded again, along with its cached fingerprint
+  unique_ptr<AuthTag> authTag = std::move(m_auth_tag);
+
   // to ensure that Nonce block points to the right memory location
   const_cast<Interest*>(this)->wireDecode(buffer.block());
 
+  if (authTag) {
+    m_auth_tag = std::move(authTag);
+    m_auth_tag_wire.reset();
+  }
+
   return m_wire;
 }
 
+size_t
+Interest::wireSize() const
+{
+  if (m_wire.hasWire())
+    return m_wire.size();
+
+  EncodingEstimator estimator;
+  return wireEncode(estimator);
+}
+
 void
 Interest::wireDecode(const Block& wire)
 {
@@ -407,10 +432,13 @@ Interest::wireDecode(const Block& wire)
       m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
     }
 
-  // AuthTag
+  // AuthTag, decoded on first access
+  m_auth_tag.reset();
   val = sportion.find( tlv::AuthTag );
   if( val != sportion.elements_end() )
-    m_auth_tag.reset( new AuthTag( *val ) );
+    m_auth_tag_wire = *val;
+  else
+    m_auth_tag_wire.reset();
 
   // SignatureInfo
   m_signature.setInfo( sportion.get( tlv::SignatureInfo ) );
@@ -429,11 +457,53 @@ Interest::wireDecode(const Block& wire)
   else
     m_auth_validity_prob = 0;
 
-  // RouteTracker
+  // RouteTracker, decoded on first access
+  m_route_tracker.reset();
   val = m_wire.find( tlv::RouteTracker );
   if( val != m_wire.elements_end() )
-    m_route_tracker.reset( new RouteTracker( *val ) );
+    m_route_tracker_wire = *val;
+  else
+    m_route_tracker_wire.reset();
+}
+
+const AuthTag*
+Interest::decodeAuthTag() const
+{
+  if (!m_auth_tag && m_auth_tag_wire.hasWire()) {
+    m_auth_tag.reset(new AuthTag(m_auth_tag_wire));
+    m_auth_tag_wire.reset();
+  }
+  return m_auth_tag.get();
+}
 
+RouteTracker*
+Interest::decodeRouteTracker() const
+{
+  if (!m_route_tracker && m_route_tracker_wire.hasWire()) {
+    m_route_tracker.reset(new RouteTracker(m_route_tracker_wire));
+    m_route_tracker_wire.reset();
+  }
+  return m_route_tracker.get();
+}
+
+void
+Interest::patchRouteTracker()
+{
+  Block wire = m_route_tracker->patchPacketWire(m_wire);
+  if (!wire.hasWire()) {
+    m_wire.reset();
+    return;
+  }
+
+  m_wire = wire;
+  m_wire.parse();
+  m_route_tracker->wireDecode(m_wire.get(tlv::RouteTracker));
+
+  // setNonce() writes into the Nonce in place, so it has to
+  // point into the new wire
+  const Block& sportion = m_wire.get(tlv::SignedPortion);
+  sportion.parse();
+  m_nonce = sportion.get(tlv::Nonce);
 }
 
 std::ostream&
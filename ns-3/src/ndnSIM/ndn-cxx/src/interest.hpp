@@ -137,6 +137,15 @@ public:
     return m_wire.hasWire();
   }
 
+  /**
+   * @brief Get the size of the wire format
+   *
+   * If the Interest has no wire, the size is estimated with
+   * EncodingEstimator instead of encoding it.
+   */
+  size_t
+  wireSize() const;
+
   /**
    * @brief Encode the name according to the NDN URI Scheme
    *
@@ -195,38 +204,47 @@ public: // Name and guiders
     return *this;
   }
 
+  /**
+  * @brief Get the AuthTag, it's decoded from the wire on first access
+  **/
   const AuthTag&
   getAuthTag() const
   {
-    if ( !m_auth_tag )
+    const AuthTag* tag = decodeAuthTag();
+    if ( !tag )
       BOOST_THROW_EXCEPTION(Error("Requested AuthTag tag does not exist"));
-    return *m_auth_tag;
+    return *tag;
   }
   
+  /**
+  * @brief Get the RouteTracker, it's decoded from the wire on first access
+  **/
   const RouteTracker&
   getRouteTracker() const
   {
-    if ( !m_route_tracker )
+    const RouteTracker* tracker = decodeRouteTracker();
+    if ( !tracker )
       BOOST_THROW_EXCEPTION(Error("Requested RouteTracker does not exist"));
-    return *m_route_tracker;
+    return *tracker;
   }
   
   const bool
   hasAuthTag() const
   {
-    return m_auth_tag != NULL;
+    return m_auth_tag != NULL || m_auth_tag_wire.hasWire();
   }
   
   const bool
   hasRouteTracker() const
   {
-    return m_route_tracker != NULL;
+    return m_route_tracker != NULL || m_route_tracker_wire.hasWire();
   }
 
   Interest&
   setAuthTag( const AuthTag& tag )
   {
     m_auth_tag.reset( new AuthTag( tag ) );
+    m_auth_tag_wire.reset();
     m_wire.reset();
     return *this;
   }
@@ -235,6 +253,7 @@ public: // Name and guiders
   setRouteTracker( const RouteTracker& tracker )
   {
     m_route_tracker.reset( new RouteTracker( tracker ) );
+    m_route_tracker_wire.reset();
     m_wire.reset();
     return *this;
   }
@@ -255,58 +274,62 @@ public: // Name and guiders
   uint64_t
   getEntryRoute() const
   {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    const RouteTracker* tracker = decodeRouteTracker();
+    if( !tracker ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to get route of data without route tracker" ) 
     );
-    return m_route_tracker->getEntryRoute();
+    return tracker->getEntryRoute();
   }
 
   uint64_t
   getInternetRoute() const
   {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    const RouteTracker* tracker = decodeRouteTracker();
+    if( !tracker ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to get route of data without route tracker" ) 
     );
-    return m_route_tracker->getInternetRoute();
+    return tracker->getInternetRoute();
   }
 
   uint64_t
   getExitRoute() const
   {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    const RouteTracker* tracker = decodeRouteTracker();
+    if( !tracker ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to get route of data without route tracker" ) 
     );
-    return m_route_tracker->getExitRoute();
+    return tracker->getExitRoute();
   }
   
   RouteTracker::NetworkType
   getCurrentNetwork() const
   {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    const RouteTracker* tracker = decodeRouteTracker();
+    if( !tracker ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to get network of data without route tracker" ) 
     );
-    return m_route_tracker->getCurrentNetwork();
+    return tracker->getCurrentNetwork();
   }
 
   Interest&
   updateRoute( uint64_t link_id )
   {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    if( !decodeRouteTracker() ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to update route of interest without route tracker" ) 
     );
     m_route_tracker->update( link_id );
-    m_wire.reset();
+    patchRouteTracker();
     return *this;
   }
   
   Interest&
   setCurrentNetwork( RouteTracker::NetworkType type )
   {
-    if( !m_route_tracker ) BOOST_THROW_EXCEPTION(
+    if( !decodeRouteTracker() ) BOOST_THROW_EXCEPTION(
        Error( "Attempt to set network of data without route tracker" ) 
     );
     m_route_tracker->setCurrentNetwork( type );
-    m_wire.reset();
+    patchRouteTracker();
     return *this;
   }
 
@@ -531,13 +554,42 @@ public: // EqualityComparable concept
     return !(*this == other);
   }
 
+private:
+  /**
+   * @brief Write the updated RouteTracker fields into the wire
+   *        instead of clearing it, the wire is cleared if it
+   *        can't be patched
+   */
+  void
+  patchRouteTracker();
+
+  /**
+   * @brief Decode the AuthTag from its wire element if that
+   *        hasn't been done yet
+   * @return the AuthTag, or nullptr if the Interest has none
+   */
+  const AuthTag*
+  decodeAuthTag() const;
+
+  /**
+   * @brief Decode the RouteTracker from its wire element if that
+   *        hasn't been done yet
+   * @return the RouteTracker, or nullptr if the Interest has none
+   */
+  RouteTracker*
+  decodeRouteTracker() const;
+
 private:
   Name m_name;
   Selectors m_selectors;
   mutable Block m_nonce;
   time::milliseconds m_interestLifetime;
-  unique_ptr<AuthTag> m_auth_tag;
-  unique_ptr<RouteTracker> m_route_tracker;
+  // the AuthTag and RouteTracker are kept as their wire elements
+  // until they're first accessed, only one of each pair is set
+  mutable unique_ptr<AuthTag> m_auth_tag;
+  mutable Block m_auth_tag_wire;
+  mutable unique_ptr<RouteTracker> m_route_tracker;
+  mutable Block m_route_tracker_wire;
   Signature m_signature;
   uint32_t m_auth_validity_prob = 0;
 
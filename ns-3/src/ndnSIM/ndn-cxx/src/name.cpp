@@ -112,6 +112,7 @@ Name::wireDecode(const Block& wire)
 
   m_nameBlock = wire;
   m_nameBlock.parse();
+  m_prefixHashes.reset();
 }
 
 void
@@ -200,6 +201,35 @@ Name::append(const PartialName& name)
   return *this;
 }
 
+const std::vector<size_t>&
+Name::getPrefixHashes(ComponentHash hash) const
+{
+  if (m_prefixHashes == nullptr || m_prefixHashFunction != hash) {
+    m_prefixHashes = make_shared<std::vector<size_t>>();
+    m_prefixHashes->reserve(size() + 1);
+    m_prefixHashes->push_back(0);
+    m_prefixHashFunction = hash;
+  }
+
+  if (m_prefixHashes->size() < size() + 1) {
+    // hashes computed before components were appended are still valid,
+    // but may be shared with copies of the name
+    if (!m_prefixHashes.unique())
+      m_prefixHashes = make_shared<std::vector<size_t>>(*m_prefixHashes);
+
+    wireEncode(); // guarantees that every component has a wire encoding
+
+    size_t hashValue = m_prefixHashes->back();
+    for (size_t i = m_prefixHashes->size() - 1; i < size(); ++i) {
+      const Component& component = get(i);
+      hashValue ^= hash(component.wire(), component.size());
+      m_prefixHashes->push_back(hashValue);
+    }
+  }
+
+  return *m_prefixHashes;
+}
+
 Name&
 Name::appendNumber(uint64_t number)
 {
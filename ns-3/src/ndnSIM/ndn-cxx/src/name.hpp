@@ -218,6 +218,7 @@ public:
   clear()
   {
     m_nameBlock = Block(tlv::Name);
+    m_prefixHashes.reset();
   }
 
   /**
@@ -607,6 +608,23 @@ public:
     return const_reverse_iterator(begin());
   }
 
+  /** \brief function computing the hash of a name component's wire encoding
+   */
+  typedef size_t (*ComponentHash)(const uint8_t* wire, size_t size);
+
+  /** \brief get the hashes of all prefixes of the name
+   *  \param hash function used to hash each component
+   *  \return a vector of size() + 1 hashes, where the i-th hash is the XOR of
+   *          the hashes of the first i components, starting with 0 for the root
+   *
+   *  The hashes are memoized.  Appending components only computes the hashes of
+   *  the new prefixes, and they're recomputed from scratch when the name is
+   *  cleared or decoded, or when a different hash function is given.  The
+   *  returned reference is valid until the name is modified.
+   */
+  const std::vector<size_t>&
+  getPrefixHashes(ComponentHash hash) const;
+
 private:
   void
   construct(const char* uri);
@@ -618,6 +636,11 @@ public:
 
 private:
   mutable Block m_nameBlock;
+
+  // memoized prefix hashes, shared between copies of the name until
+  // one of them needs to extend them
+  mutable shared_ptr<std::vector<size_t>> m_prefixHashes;
+  mutable ComponentHash m_prefixHashFunction = nullptr;
 };
 
 std::ostream&
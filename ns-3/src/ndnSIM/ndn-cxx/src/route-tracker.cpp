@@ -61,6 +61,26 @@ namespace ndn
     }
     
 
+    namespace
+    {
+        /**
+        * Route hashes are always encoded as 8 byte non negative
+        * integers, so the encoded size of a tracker doesn't depend
+        * on its hashes and updates can be patched into the wire;
+        * readNonNegativeInteger() still accepts the shorter forms
+        **/
+        template<encoding::Tag TAG>
+        size_t prependFixedWidthIntegerBlock( EncodingImpl< TAG >& encoder,
+                                              uint32_t type,
+                                              uint64_t value )
+        {
+            uint8_t bytes[8];
+            for( size_t i = 0 ; i < 8 ; i++ )
+                bytes[i] = value >> ( 8*( 7 - i ) );
+            return encoder.prependByteArrayBlock( type, bytes, sizeof(bytes) );
+        }
+    }
+
     template<encoding::Tag TAG>
     size_t RouteTracker::wireEncode( EncodingImpl< TAG > &encoder ) const
     {
@@ -70,23 +90,23 @@ namespace ndn
         *                   EntryRoute
         *                   InternetRoute
         *                   ExitRoute
-        * ( reverse encoding )
+        * ( reverse encoding, routes are fixed width )
         **/
 
         size_t length = 0;
 
         // ExitRoute
-        length += prependNonNegativeIntegerBlock( encoder,
-                                                  tlv::ExitRoute,
-                                                  m_exit_route );
+        length += prependFixedWidthIntegerBlock( encoder,
+                                                 tlv::ExitRoute,
+                                                 m_exit_route );
         // InternetRoute
-        length += prependNonNegativeIntegerBlock( encoder,
-                                                  tlv::InternetRoute,
-                                                  m_internet_route );
+        length += prependFixedWidthIntegerBlock( encoder,
+                                                 tlv::InternetRoute,
+                                                 m_internet_route );
         // EntryRoute
-        length += prependNonNegativeIntegerBlock( encoder,
-                                                  tlv::EntryRoute,
-                                                  m_entry_route );
+        length += prependFixedWidthIntegerBlock( encoder,
+                                                 tlv::EntryRoute,
+                                                 m_entry_route );
         // CurrentNetwork
         length += prependNonNegativeIntegerBlock( encoder,
                                                   tlv::CurrentNetwork,
@@ -155,4 +175,65 @@ namespace ndn
     {
         return m_wire.hasWire();
     };
+
+    Block RouteTracker::patchPacketWire( const Block& packet ) const
+    {
+        if( !packet.hasWire() )
+            return Block();
+
+        packet.parse();
+        Block::element_const_iterator tracker = packet.find( tlv::RouteTracker );
+        if( tracker == packet.elements_end() )
+            return Block();
+        tracker->parse();
+
+        struct Field
+        {
+            uint32_t type;
+            uint64_t value;
+            size_t   offset;
+            size_t   width;
+        };
+        Field fields[] =
+        {
+            { tlv::CurrentNetwork, (uint64_t)m_current_network, 0, 0 },
+            { tlv::EntryRoute,     m_entry_route,               0, 0 },
+            { tlv::InternetRoute,  m_internet_route,            0, 0 },
+            { tlv::ExitRoute,      m_exit_route,                0, 0 }
+        };
+
+        // make sure every field still fits before copying anything
+        const uint8_t* base = packet.wire();
+        for( Field& field : fields )
+        {
+            Block::element_const_iterator val = tracker->find( field.type );
+            if( val == tracker->elements_end() )
+                return Block();
+
+            // elements of a packet that was built rather than
+            // decoded may not point into the packet's own wire
+            if( val->value() < base
+              || val->value() + val->value_size() > base + packet.size() )
+                return Block();
+
+            field.offset = val->value() - base;
+            field.width = val->value_size();
+            if( field.width != 1 && field.width != 2
+              && field.width != 4 && field.width != 8 )
+                return Block();
+            if( field.width < 8 && ( field.value >> ( 8*field.width ) ) != 0 )
+                return Block();
+        }
+
+        // non negative integers are big endian
+        shared_ptr<Buffer> buffer = make_shared<Buffer>( packet.begin(), packet.end() );
+        for( const Field& field : fields )
+        {
+            uint8_t* dst = buffer->buf() + field.offset;
+            for( size_t i = 0 ; i < field.width ; i++ )
+                dst[i] = field.value >> ( 8*( field.width - i - 1 ) );
+        }
+
+        return Block( buffer );
+    };
 }
@@ -110,6 +110,25 @@ namespace ndn
             **/
             bool hasWire() const;
             
+            /**
+            * @brief Write the tracker's current fields into the
+            *        wire of the packet that carries it
+            *
+            * The packet is left as is, the fields are written
+            * into a copy of its wire since the wire's buffer may be
+            * shared with other copies of the packet.  Each field is
+            * written at its existing offset and width, so the rest
+            * of the packet doesn't need to be re-encoded.
+            *
+            * @param packet  Wire of the Interest or Data that
+            *                carries the tracker
+            * @return The patched packet wire, or an empty Block if the
+            *         packet has no tracker or a field no longer fits
+            *         its encoded width; in which case the packet needs
+            *         to be re-encoded
+            **/
+            Block patchPacketWire( const Block& packet ) const;
+            
     private:
             mutable Block m_wire;
             NetworkType   m_current_network;
@@ -2,6 +2,25 @@
 * @class ndntac::AuthCache
 * A bloom filter wrapper for caching AuthTags.
 *
+* The cache is split into one or more generations, each of which
+* is its own bloom filter.  Inserts always go to the newest generation,
+* and lookups check all of them.  When the newest generation becomes
+* saturated a new one is started and the oldest is retired, so only
+* a fraction of the cached tags are forgotten at a time instead of
+* clearing the whole cache at once.  A generation is also retired
+* early once every tag inserted into it has expired.
+*
+* With a single generation the cache behaves like a plain bloom
+* filter that's cleared on saturation.
+*
+* Each generation can use either the standard bloom_filter, the
+* cache line BlockedBloomFilter, or the CountingBloomFilter as its
+* backend.  Only the counting backend supports erasing tags.
+*
+* Alternatively the ExactAuthCache can be used as the backend, in
+* which case there are no generations and no false positives; the
+* cache is just a wrapper around the exact cache.
+*
 * @author Ray Stubbs [stubbs.ray@gmail.com]
 **/
 
@@ -10,63 +29,228 @@
 
 #include "ndn-cxx/auth-tag.hpp"
 #include "bloom_filter.hpp"
-#include <cryptopp/rsa.h>
+#include "blocked-bloom-filter.hpp"
+#include "counting-bloom-filter.hpp"
+#include "exact-auth-cache.hpp"
+#include <deque>
+#include <memory>
 
 namespace ndntac
 {
 
   class AuthCache
   {
+  public:
+    enum Backend
+    {
+      StandardBloomBackend,
+      BlockedBloomBackend,
+      CountingBloomBackend,
+      ExactBackend
+    };
+
   private:
-    bloom_filter m_bloom;
-    double       m_max_fpp;
+    // common interface to the backend filters, which all
+    // implement insert_digest, contains_digest and effective_fpp
+    struct Filter
+    {
+      virtual ~Filter() {}
+      virtual void insert( uint64_t h1, uint64_t h2 ) = 0;
+      virtual bool contains( uint64_t h1, uint64_t h2 ) const = 0;
+      virtual double fpp() const = 0;
+
+      // only supported by backends that implement erase_digest
+      virtual bool erase( uint64_t, uint64_t )
+      {
+        return false;
+      }
+    };
+
+    template< typename FilterType >
+    struct FilterImpl : Filter
+    {
+      FilterImpl( const bloom_parameters& params )
+        : filter( params )
+      {}
+
+      void insert( uint64_t h1, uint64_t h2 ) override
+      {
+        filter.insert_digest( h1, h2 );
+      }
+
+      bool contains( uint64_t h1, uint64_t h2 ) const override
+      {
+        return filter.contains_digest( h1, h2 );
+      }
+
+      double fpp() const override
+      {
+        return filter.effective_fpp();
+      }
+
+      FilterType filter;
+    };
+
+    struct CountingFilterImpl : FilterImpl< CountingBloomFilter >
+    {
+      CountingFilterImpl( const bloom_parameters& params )
+        : FilterImpl< CountingBloomFilter >( params )
+      {}
+
+      bool erase( uint64_t h1, uint64_t h2 ) override
+      {
+        return filter.erase_digest( h1, h2 );
+      }
+    };
+
+    struct Generation
+    {
+      Generation( const bloom_parameters& params, Backend backend )
+        : expiration( ndn::time::system_clock::TimePoint::min() )
+      {
+        if( backend == BlockedBloomBackend )
+          bloom.reset( new FilterImpl< BlockedBloomFilter >( params ) );
+        else if( backend == CountingBloomBackend )
+          bloom.reset( new CountingFilterImpl( params ) );
+        else
+          bloom.reset( new FilterImpl< bloom_filter >( params ) );
+      }
+
+      std::unique_ptr< Filter > bloom;
+
+      // latest expiration time of all tags in the generation
+      ndn::time::system_clock::TimePoint expiration;
+    };
+
+    std::deque< Generation > m_generations;
+    std::unique_ptr< ExactAuthCache > m_exact;
+    bloom_parameters         m_params;
+    uint32_t                 m_max_generations;
+    double                   m_max_fpp;
+    Backend                  m_backend;
 
   public:
 
     /**
     * @brief Constructor
-    * @param fpp  Max tolorable false positive probability
-    * @param n    Max number of items to be stored in the bloom filter
+    * @param fpp          Max tolorable false positive probability
+    * @param n            Max number of items to be stored in the cache
+    * @param generations  Number of generations to split the cache into,
+    *                     unused by the exact backend
+    * @param backend      Type of bloom filter to use for each generation
     **/
-    AuthCache( double fpp, uint32_t n )
+    AuthCache( double fpp, uint32_t n, uint32_t generations = 1,
+               Backend backend = StandardBloomBackend )
     {
-      m_max_fpp = fpp;
+      m_backend = backend;
+      if( m_backend == ExactBackend )
+      {
+        // the exact cache has no generations or false positives
+        m_max_generations = 1;
+        m_max_fpp = 0;
+        m_exact.reset( new ExactAuthCache( n ) );
+        return;
+      }
+
+      m_max_generations = std::max( generations, (uint32_t)1 );
+
+      // lookups check every generation so the false positive
+      // probabilities add up, we split the max fpp between them
+      m_max_fpp = fpp / m_max_generations;
 
-      bloom_parameters bparams;
-      bparams.projected_element_count = n;
-      bparams.false_positive_probability = fpp;
-      bparams.compute_optimal_parameters();
-      m_bloom = bloom_filter( bparams );
+      m_params.projected_element_count =
+        std::max( n / m_max_generations, (uint32_t)1 );
+      m_params.false_positive_probability = m_max_fpp;
+      m_params.compute_optimal_parameters();
+
+      m_generations.emplace_front( m_params, m_backend );
     }
 
     /**
-    * @brief Insert a tag into the bloom filter
+    * @brief Insert a tag into the cache
     * @param tag  Tag to insert
     **/
     void insert( const ndn::AuthTag& tag )
     {
-      uint8_t digest[CryptoPP::SHA256::DIGESTSIZE];
-      CryptoPP::SHA256 hash;
-      const ndn::Block& encoded = tag.wireEncode();
-      hash.CalculateDigest( digest, encoded.wire() , encoded.size() );
-      m_bloom.insert( digest, CryptoPP::SHA256::DIGESTSIZE );
+      if( m_exact )
+      {
+        m_exact->insert( tag );
+        return;
+      }
+
+      // the tag's fingerprint is cached by the tag, so repeated
+      // lookups of the same tag don't rehash or re-encode it
+      const uint64_t* fp = tag.getFingerprint();
+      Generation& newest = m_generations.front();
+
+      // a tag is only counted once per generation, otherwise
+      // repeated inserts would inflate the fpp estimate and a
+      // single erase wouldn't remove a tag from a counting filter
+      if( !newest.bloom->contains( fp[0], fp[1] ) )
+        newest.bloom->insert( fp[0], fp[1] );
+      try
+      {
+        newest.expiration = std::max( newest.expiration,
+                                      tag.getExpirationTime() );
+      }
+      catch( ... )
+      {
+        // tags without a validity period never expire
+        newest.expiration = ndn::time::system_clock::TimePoint::max();
+      }
     }
 
     /**
-    * @brief Check for a tag in the bloom filter
+    * @brief Check for a tag in the cache
     * @param tag   Tag to check for
-    * @return true if tag is in filter false otherwise
+    * @return true if tag is in cache false otherwise
     **/
     bool contains( const ndn::AuthTag& tag )
     {
-      if( m_bloom.effective_fpp() > m_max_fpp )
-        m_bloom.clear();
-
-      uint8_t digest[CryptoPP::SHA256::DIGESTSIZE];
-      CryptoPP::SHA256 hash;
-      const ndn::Block& encoded = tag.wireEncode();
-      hash.CalculateDigest( digest, encoded.wire() , encoded.size() );
-      return m_bloom.contains( digest, CryptoPP::SHA256::DIGESTSIZE );
+      if( m_exact )
+        return m_exact->contains( tag );
+
+      retire();
+
+      const uint64_t* fp = tag.getFingerprint();
+      for( auto it = m_generations.begin()
+         ; it != m_generations.end()
+         ; it++ )
+      {
+        if( it->bloom->contains( fp[0], fp[1] ) )
+        {
+          // tags found in an older generation are moved up to
+          // the newest one so tags in use survive rotation
+          if( it != m_generations.begin() )
+            insert( tag );
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /**
+    * @brief Erase a tag from the cache
+    *
+    * Does nothing unless the cache uses a backend that supports
+    * erasing.  Since a tag is erased from a generation whenever
+    * the generation contains it, erasing a tag that was never
+    * inserted may erase other tags as well; so tags should only
+    * be erased if they're known to have been inserted.
+    *
+    * @param tag   Tag to erase
+    * @return true if the tag was erased from any generation
+    **/
+    bool erase( const ndn::AuthTag& tag )
+    {
+      if( m_exact )
+        return m_exact->erase( tag );
+
+      const uint64_t* fp = tag.getFingerprint();
+      bool erased = false;
+      for( Generation& generation : m_generations )
+        erased = generation.bloom->erase( fp[0], fp[1] ) || erased;
+      return erased;
     }
 
     /**
@@ -75,7 +259,45 @@ namespace ndntac
     **/
     double getEffectiveFPP() const
     {
-      return m_bloom.effective_fpp();
+      if( m_exact )
+        return 0;
+
+      double fpp = 0;
+      for( const Generation& generation : m_generations )
+        fpp += generation.bloom->fpp();
+      return std::min( fpp, 1.0 );
+    }
+
+    /**
+    * @brief Return true if the cache has no false positives, and
+    *        only holds unexpired tags
+    **/
+    bool isExact() const
+    {
+      return m_exact != nullptr;
+    }
+
+  private:
+
+    /**
+    * @brief Retire expired generations and start a new generation
+    *        if the newest one is saturated
+    **/
+    void retire()
+    {
+      auto now = ndn::time::system_clock::now();
+      while( m_generations.size() > 1
+           && m_generations.back().expiration < now )
+      {
+        m_generations.pop_back();
+      }
+
+      if( m_generations.front().bloom->fpp() > m_max_fpp )
+      {
+        m_generations.emplace_front( m_params, m_backend );
+        if( m_generations.size() > m_max_generations )
+          m_generations.pop_back();
+      }
     }
 
   };
@@ -0,0 +1,269 @@
+/**
+* @class ndntac::BlockedBloomFilter
+* A cache line blocked bloom filter.
+*
+* All k bits of a key are placed within a single 64 byte block
+* of the table, so a lookup touches one cache line instead of k
+* random ones.  The key's bits are first gathered into a block
+* sized mask, which is then tested against ( or or'd onto ) the
+* table block with SSE2 or AVX2 when available.
+*
+* Blocking raises the false positive rate for a given table size
+* since some blocks end up more loaded than others, so the table is
+* sized to meet the requested false positive probability under the
+* block load distribution rather than with the standard formula.
+*
+* The insert_digest/contains_digest/effective_fpp contract matches
+* that of bloom_filter, so either can be used as an AuthCache backend.
+**/
+
+#ifndef BLOCKED_BLOOM_FILTER_INCLUDED
+#define BLOCKED_BLOOM_FILTER_INCLUDED
+
+#include "bloom_filter.hpp"
+#include <boost/noncopyable.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <new>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ndntac
+{
+
+  class BlockedBloomFilter : boost::noncopyable
+  {
+  public:
+    static const size_t BLOCK_SIZE = 64;
+    static const size_t BLOCK_BITS = BLOCK_SIZE*8;
+    static const size_t BLOCK_WORDS = BLOCK_SIZE/sizeof(uint64_t);
+
+  private:
+    struct Block
+    {
+      uint64_t words[BLOCK_WORDS];
+    };
+
+    Block*   m_blocks;
+    uint64_t m_block_count;
+    uint32_t m_hash_count;
+    uint64_t m_inserted;
+
+    // effective_fpp() is called on every AuthCache lookup,
+    // so it's only recomputed after an insert
+    mutable double   m_fpp;
+    mutable uint64_t m_fpp_inserted;
+
+  public:
+
+    /**
+    * @brief Constructor
+    * @param params  Parameters with projected element count,
+    *                desired false positive probability and optimal
+    *                parameters already computed
+    **/
+    BlockedBloomFilter( const bloom_parameters& params )
+      : m_blocks( 0 )
+      , m_inserted( 0 )
+      , m_fpp( 0 )
+      , m_fpp_inserted( 0 )
+    {
+      // k bits need to fit comfortably into a single block
+      m_hash_count = std::min( params.optimal_parameters.number_of_hashes,
+                               (unsigned int)BLOCK_BITS/8 );
+      m_hash_count = std::max( m_hash_count, (uint32_t)1 );
+
+      // start from the size of an equivalent standard filter and
+      // grow it until the blocked fpp meets the desired bound
+      m_block_count = params.optimal_parameters.table_size/BLOCK_BITS + 1;
+      double n = params.projected_element_count;
+      for( int i = 0 ; i < 64 ; i++ )
+      {
+        if( fpp( n/m_block_count ) <= params.false_positive_probability )
+          break;
+        m_block_count += m_block_count/8 + 1;
+      }
+
+      void* mem = 0;
+      if( posix_memalign( &mem, BLOCK_SIZE, m_block_count*sizeof(Block) ) != 0 )
+        throw std::bad_alloc();
+      m_blocks = static_cast< Block* >( mem );
+      clear();
+    }
+
+    ~BlockedBloomFilter()
+    {
+      std::free( m_blocks );
+    }
+
+    void clear()
+    {
+      std::memset( m_blocks, 0, m_block_count*sizeof(Block) );
+      m_inserted = 0;
+      m_fpp = 0;
+      m_fpp_inserted = 0;
+    }
+
+    void insert_digest( uint64_t h1, uint64_t h2 )
+    {
+      Block mask;
+      Block& block = m_blocks[ select( h1, h2, mask ) ];
+
+#if defined(__AVX2__)
+      for( size_t i = 0 ; i < BLOCK_WORDS ; i += 4 )
+      {
+        __m256i* dst = reinterpret_cast< __m256i* >( block.words + i );
+        __m256i  msk = _mm256_loadu_si256
+                       ( reinterpret_cast< const __m256i* >( mask.words + i ) );
+        _mm256_store_si256( dst, _mm256_or_si256( _mm256_load_si256( dst ), msk ) );
+      }
+#elif defined(__SSE2__)
+      for( size_t i = 0 ; i < BLOCK_WORDS ; i += 2 )
+      {
+        __m128i* dst = reinterpret_cast< __m128i* >( block.words + i );
+        __m128i  msk = _mm_loadu_si128
+                       ( reinterpret_cast< const __m128i* >( mask.words + i ) );
+        _mm_store_si128( dst, _mm_or_si128( _mm_load_si128( dst ), msk ) );
+      }
+#else
+      for( size_t i = 0 ; i < BLOCK_WORDS ; i++ )
+        block.words[i] |= mask.words[i];
+#endif
+      m_inserted++;
+    }
+
+    bool contains_digest( uint64_t h1, uint64_t h2 ) const
+    {
+      Block mask;
+      const Block& block = m_blocks[ select( h1, h2, mask ) ];
+
+#if defined(__AVX2__)
+      for( size_t i = 0 ; i < BLOCK_WORDS ; i += 4 )
+      {
+        __m256i blk = _mm256_load_si256
+                      ( reinterpret_cast< const __m256i* >( block.words + i ) );
+        __m256i msk = _mm256_loadu_si256
+                      ( reinterpret_cast< const __m256i* >( mask.words + i ) );
+        // all mask bits are set iff ( mask & ~block ) == 0
+        if( !_mm256_testz_si256( msk, _mm256_xor_si256( blk, _mm256_set1_epi8( -1 ) ) ) )
+          return false;
+      }
+      return true;
+#elif defined(__SSE2__)
+      for( size_t i = 0 ; i < BLOCK_WORDS ; i += 2 )
+      {
+        __m128i blk = _mm_load_si128
+                      ( reinterpret_cast< const __m128i* >( block.words + i ) );
+        __m128i msk = _mm_loadu_si128
+                      ( reinterpret_cast< const __m128i* >( mask.words + i ) );
+        __m128i cmp = _mm_cmpeq_epi8( _mm_and_si128( blk, msk ), msk );
+        if( _mm_movemask_epi8( cmp ) != 0xFFFF )
+          return false;
+      }
+      return true;
+#else
+      for( size_t i = 0 ; i < BLOCK_WORDS ; i++ )
+      {
+        if( ( block.words[i] & mask.words[i] ) != mask.words[i] )
+          return false;
+      }
+      return true;
+#endif
+    }
+
+    double effective_fpp() const
+    {
+      if( m_fpp_inserted != m_inserted )
+      {
+        m_fpp = fpp( (double)m_inserted/m_block_count );
+        m_fpp_inserted = m_inserted;
+      }
+      return m_fpp;
+    }
+
+    uint64_t size() const
+    {
+      return m_block_count*BLOCK_BITS;
+    }
+
+    uint64_t element_count() const
+    {
+      return m_inserted;
+    }
+
+  private:
+
+    /**
+    * @brief Pick the block for a key and build the key's bit mask
+    * @return Index of the selected block
+    **/
+    uint64_t select( uint64_t h1, uint64_t h2, Block& mask ) const
+    {
+      std::memset( mask.words, 0, sizeof(mask.words) );
+
+      // bit positions within the block are taken 9 bits at a
+      // time from a splitmix64 stream seeded with the half of the
+      // digest not used for selecting the block; double hashing
+      // mod 512 would only give 2^17 distinct masks
+      uint64_t state = h2;
+      uint64_t bits = 0;
+      uint32_t avail = 0;
+      for( uint32_t i = 0 ; i < m_hash_count ; i++ )
+      {
+        if( avail == 0 )
+        {
+          bits = splitmix64( state );
+          avail = 64/9;
+        }
+        uint32_t bit = bits % BLOCK_BITS;
+        bits >>= 9;
+        avail--;
+        mask.words[ bit/64 ] |= (uint64_t)1 << ( bit%64 );
+      }
+      return h1 % m_block_count;
+    }
+
+    static uint64_t splitmix64( uint64_t& state )
+    {
+      uint64_t z = ( state += 0x9e3779b97f4a7c15ULL );
+      z = ( z ^ ( z >> 30 ) )*0xbf58476d1ce4e5b9ULL;
+      z = ( z ^ ( z >> 27 ) )*0x94d049bb133111ebULL;
+      return z ^ ( z >> 31 );
+    }
+
+    /**
+    * @brief Estimate the false positive probability given the mean
+    *        number of keys per block
+    *
+    * Block loads are approximately Poisson distributed, the fpp
+    * is the expected fpp of a single block under that distribution.
+    **/
+    double fpp( double load ) const
+    {
+      // at this point every block is practically full
+      if( load > 500 )
+        return 1.0;
+
+      double p = std::exp( -load );
+      double sum = 0;
+      size_t max_load = load + 12*std::sqrt( load ) + 32;
+      for( size_t j = 0 ; j <= max_load ; j++ )
+      {
+        double fill = 1.0 - std::pow( 1.0 - 1.0/BLOCK_BITS,
+                                      (double)m_hash_count*j );
+        sum += p*std::pow( fill, (double)m_hash_count );
+        p *= load/( j + 1 );
+      }
+      return std::min( sum, 1.0 );
+    }
+  };
+
+};
+
+#endif // BLOCKED_BLOOM_FILTER_INCLUDED
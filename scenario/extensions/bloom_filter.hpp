@@ -192,6 +192,7 @@ public:
    }
 
    bloom_filter(const bloom_filter& filter)
+   : bit_table_(0)
    {
       this->operator=(filter);
    }
@@ -294,6 +295,35 @@ public:
       }
    }
 
+   /*
+     Double hashing variant of insert/contains for callers that already
+     hold a well mixed 128-bit digest of the key.  The k bit indices are
+     derived as (h1 + i * h2) instead of rehashing the key once per salt.
+   */
+   inline void insert_digest(const unsigned long long int h1, const unsigned long long int h2)
+   {
+      for (std::size_t i = 0; i < salt_.size(); ++i)
+      {
+         const unsigned long long int bit_index = (h1 + i * h2) % table_size_;
+         bit_table_[bit_index / bits_per_char] |= bit_mask[bit_index % bits_per_char];
+      }
+      ++inserted_element_count_;
+   }
+
+   inline bool contains_digest(const unsigned long long int h1, const unsigned long long int h2) const
+   {
+      for (std::size_t i = 0; i < salt_.size(); ++i)
+      {
+         const unsigned long long int bit_index = (h1 + i * h2) % table_size_;
+         const std::size_t bit = bit_index % bits_per_char;
+         if ((bit_table_[bit_index / bits_per_char] & bit_mask[bit]) != bit_mask[bit])
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
    inline virtual bool contains(const unsigned char* key_begin, const std::size_t length) const
    {
       std::size_t bit_index = 0;
@@ -90,6 +90,8 @@ Consumer::OnData( std::shared_ptr< const Data > data )
     // update data trace
     tracers::consumer->data
     ( *data, info.fx_time, info.lx_time, Simulator::Now() );
+    tracers::spans->request
+    ( info.interest->getNonce(), info.lx_time, Simulator::Now() );
     
     // if nack then update nack traces
     if( data->getContentType() == tlv::ContentType_Nack )
@@ -0,0 +1,146 @@
+/**
+* @class ndntac::CountingBloomFilter
+* A bloom filter with 4 bit counters in place of bits, which
+* allows elements to be erased.
+*
+* Inserting increments the key's k counters and erasing decrements
+* them.  A counter that reaches its max value sticks there, since
+* its true count is no longer known, so erasing never produces a
+* false negative for keys that were actually inserted.  Erasing a
+* key that was never inserted (a false positive) can though, so only
+* keys known to be in the filter should be erased.
+*
+* The insert_digest/contains_digest/effective_fpp contract matches
+* that of bloom_filter, so either can be used as an AuthCache backend.
+**/
+
+#ifndef COUNTING_BLOOM_FILTER_INCLUDED
+#define COUNTING_BLOOM_FILTER_INCLUDED
+
+#include "bloom_filter.hpp"
+#include <boost/noncopyable.hpp>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+namespace ndntac
+{
+
+  class CountingBloomFilter : boost::noncopyable
+  {
+  public:
+    static const uint8_t MAX_COUNT = 0xF;
+
+  private:
+    // two counters per byte, low nibble first
+    std::vector< uint8_t > m_counters;
+    uint64_t               m_table_size;
+    uint32_t               m_hash_count;
+    uint64_t               m_element_count;
+
+  public:
+
+    /**
+    * @brief Constructor
+    * @param params  Parameters with projected element count,
+    *                desired false positive probability and optimal
+    *                parameters already computed
+    **/
+    CountingBloomFilter( const bloom_parameters& params )
+      : m_table_size( std::max( params.optimal_parameters.table_size,
+                                (unsigned long long int)1 ) )
+      , m_hash_count( std::max( params.optimal_parameters.number_of_hashes,
+                                (unsigned int)1 ) )
+      , m_element_count( 0 )
+    {
+      m_counters.resize( ( m_table_size + 1 )/2, 0 );
+    }
+
+    void clear()
+    {
+      std::fill( m_counters.begin(), m_counters.end(), 0 );
+      m_element_count = 0;
+    }
+
+    void insert_digest( uint64_t h1, uint64_t h2 )
+    {
+      for( uint32_t i = 0 ; i < m_hash_count ; i++ )
+      {
+        uint64_t index = ( h1 + i*h2 ) % m_table_size;
+        uint8_t count = get( index );
+        if( count < MAX_COUNT )
+          set( index, count + 1 );
+      }
+      m_element_count++;
+    }
+
+    bool contains_digest( uint64_t h1, uint64_t h2 ) const
+    {
+      for( uint32_t i = 0 ; i < m_hash_count ; i++ )
+      {
+        if( get( ( h1 + i*h2 ) % m_table_size ) == 0 )
+          return false;
+      }
+      return true;
+    }
+
+    /**
+    * @brief Erase a key from the filter
+    * @return true if the key was in the filter and has been
+    *         erased, false if it wasn't in the filter
+    **/
+    bool erase_digest( uint64_t h1, uint64_t h2 )
+    {
+      if( !contains_digest( h1, h2 ) )
+        return false;
+
+      for( uint32_t i = 0 ; i < m_hash_count ; i++ )
+      {
+        uint64_t index = ( h1 + i*h2 ) % m_table_size;
+        uint8_t count = get( index );
+        if( count < MAX_COUNT )
+          set( index, count - 1 );
+      }
+      if( m_element_count > 0 )
+        m_element_count--;
+      return true;
+    }
+
+    double effective_fpp() const
+    {
+      return std::pow( 1.0 - std::exp( -1.0*m_hash_count*m_element_count
+                                       /m_table_size ),
+                       1.0*m_hash_count );
+    }
+
+    uint64_t size() const
+    {
+      return m_table_size;
+    }
+
+    uint64_t element_count() const
+    {
+      return m_element_count;
+    }
+
+  private:
+
+    uint8_t get( uint64_t index ) const
+    {
+      uint8_t byte = m_counters[ index/2 ];
+      return ( index & 1 ) ? ( byte >> 4 ) : ( byte & 0xF );
+    }
+
+    void set( uint64_t index, uint8_t count )
+    {
+      uint8_t& byte = m_counters[ index/2 ];
+      if( index & 1 )
+        byte = ( byte & 0x0F ) | ( count << 4 );
+      else
+        byte = ( byte & 0xF0 ) | count;
+    }
+  };
+
+};
+
+#endif // COUNTING_BLOOM_FILTER_INCLUDED
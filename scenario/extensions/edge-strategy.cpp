@@ -11,27 +11,29 @@ namespace ndntac
   EdgeStrategy::STRATEGY_NAME = "ndn:/localhost/nfd/strategy/ndntac-edge-strategy";
   string
   EdgeStrategy::s_config = "config/edge_config.jx9";
-  const ns3::Time
-  EdgeStrategy::s_edge_signature_delay = ns3::NanoSeconds( 30345 );
-  const ns3::Time
-  EdgeStrategy::s_edge_bloom_delay = ns3::NanoSeconds( 2535 );
   
   
   EdgeStrategy::EdgeStrategy( nfd::Forwarder& forwarder,
                               const ndn::Name& name )
-    : RouterStrategy( forwarder, name )
-    , m_positive_cache( 1e-10, 10000 )
-    , m_negative_cache( 1e-10, 10000 )
+    : RouterStrategy( forwarder, name, s_config )
+    , m_positive_cache( m_config.positive_cache.fpp,
+                        m_config.positive_cache.size,
+                        m_config.positive_cache.generations,
+                        m_config.positive_cache.backend )
+    , m_negative_cache( m_config.negative_cache.fpp,
+                        m_config.negative_cache.size,
+                        m_config.negative_cache.generations,
+                        m_config.negative_cache.backend )
   { }
 
 bool
 EdgeStrategy::filterOutgoingData
 ( const nfd::Face& face,
   const ndn::Interest& interest,
-  ndn::Data& data,
+  nfd::fw::OutgoingData& data,
   ns3::Time& delay )
 {
-    auto in_face = getFaceTable().get( data.getIncomingFaceId() );
+    auto in_face = getFaceTable().get( data.get().getIncomingFaceId() );
     bool coming_from_network = !in_face->isEdge();
     bool going_to_network = !face.isEdge();
     
@@ -48,10 +50,10 @@ EdgeStrategy::filterOutgoingData
     // we just change its current network
     if( going_to_network )
     {
-        BOOST_ASSERT( data.getCurrentNetwork()
+        BOOST_ASSERT( data.get().getCurrentNetwork()
                     == ndn::RouteTracker::EXIT_NETWORK );
-        tracers::edge->data_entered( data );
-        data.setCurrentNetwork( ndn::RouteTracker::INTERNET_NETWORK );
+        tracers::edge->data_entered( data.get() );
+        data.modify().setCurrentNetwork( ndn::RouteTracker::INTERNET_NETWORK );
         return RouterStrategy::filterOutgoingData
                ( face, interest, data, delay ); 
     }
@@ -60,10 +62,10 @@ EdgeStrategy::filterOutgoingData
     // its current network
     if( coming_from_network )
     {
-        BOOST_ASSERT( data.getCurrentNetwork()
+        BOOST_ASSERT( data.get().getCurrentNetwork()
                     == ndn::RouteTracker::INTERNET_NETWORK );
-        tracers::edge->data_left( data );
-        data.setCurrentNetwork( ndn::RouteTracker::ENTRY_NETWORK );
+        tracers::edge->data_left( data.get() );
+        data.modify().setCurrentNetwork( ndn::RouteTracker::ENTRY_NETWORK );
         return RouterStrategy::filterOutgoingData
                ( face, interest, data, delay );
     }
@@ -123,10 +125,37 @@ EdgeStrategy::filterOutgoingInterest
     
     const ndn::AuthTag& auth = interest.getAuthTag();
 
+    // an exact positive cache only holds unexpired tags, so
+    // if the tag's there we can skip the expiration check
+    bool positive_checked = false;
+    bool positive_hit = false;
+    if( m_positive_cache.isExact() )
+    {
+        tracers::edge->bloom_lookup( auth, m_config.bloom_delay );
+        tracers::spans->span( interest.getNonce(), tracers::SpanEdgeBloom,
+                              m_config.bloom_delay );
+        delay += m_config.bloom_delay;
+        positive_hit = m_positive_cache.contains( auth );
+        tracers::edge->cache_lookup( auth, tracers::EdgeCachePositive,
+                                     positive_hit );
+        positive_checked = true;
+    }
+
     // if the auth tag provided by the interest is expired
     // then we can drop the interest
-    if( auth.isExpired() )
+    if( !positive_hit && auth.isExpired() )
     {
+        // the tag will never be valid again, so we remove it
+        // from the caches if their backends support erasing; an
+        // exact positive cache was already checked and missed.
+        // A counting filter only erases tags it appears to hold,
+        // though a false positive still erases other tags' counts,
+        // which at worst costs those tags another verification
+        if( !positive_checked && m_positive_cache.erase( auth ) )
+            delay += m_config.bloom_delay;
+        if( m_negative_cache.erase( auth ) )
+            delay += m_config.bloom_delay;
+
         tracers::edge->blocked_interest
         ( interest, tracers::BlockedExpired );
         onInterestDropped( interest, face, "Expired auth" );
@@ -155,9 +184,17 @@ EdgeStrategy::filterOutgoingInterest
     
     // if the interest auth is in the positive auth cache then
     // we set its auth validity probability
-    tracers::edge->bloom_lookup( auth, s_edge_bloom_delay );
-    delay += s_edge_bloom_delay;
-    if( m_positive_cache.contains( auth ) )
+    if( !positive_checked )
+    {
+        tracers::edge->bloom_lookup( auth, m_config.bloom_delay );
+        tracers::spans->span( interest.getNonce(), tracers::SpanEdgeBloom,
+                              m_config.bloom_delay );
+        delay += m_config.bloom_delay;
+        positive_hit = m_positive_cache.contains( auth );
+        tracers::edge->cache_lookup( auth, tracers::EdgeCachePositive,
+                                     positive_hit );
+    }
+    if( positive_hit )
     {
         double fpp = m_positive_cache.getEffectiveFPP();
         double prob = (double)1.0 - fpp;
@@ -169,16 +206,32 @@ EdgeStrategy::filterOutgoingInterest
     {
         // if it's in the negative cache then we validate
         // its signature manually
-        tracers::edge->bloom_lookup( auth, s_edge_bloom_delay );
-        delay += s_edge_bloom_delay;
-        if( m_negative_cache.contains( auth ) )
+        tracers::edge->bloom_lookup( auth, m_config.bloom_delay );
+        tracers::spans->span( interest.getNonce(), tracers::SpanEdgeBloom,
+                              m_config.bloom_delay );
+        delay += m_config.bloom_delay;
+        bool negative_hit = m_negative_cache.contains( auth );
+        tracers::edge->cache_lookup( auth, tracers::EdgeCacheNegative,
+                                     negative_hit );
+        if( negative_hit )
         {
             // we simulate verification delay by incrementing
             // the processing delay
-            tracers::edge->sigverif( auth, s_edge_signature_delay );
-            delay += EdgeStrategy::s_edge_signature_delay;
-            if( auth.getSignature().getValue().value_size() > 0
-              && auth.getSignature().getValue().value()[0] != 0 )
+            ns3::Time verif_start = delay;
+            bool valid = lookupKeyContext( auth, delay,
+                                           tracers::edge->key_context );
+            if( valid )
+            {
+                ns3::Time sigverif_delay = m_config.sigverif_delay;
+                valid = SignatureVerifier::get().verify
+                        ( auth, m_config.signature_mode, sigverif_delay );
+                tracers::edge->sigverif( auth, sigverif_delay );
+                delay += sigverif_delay;
+            }
+            tracers::spans->span( interest.getNonce(),
+                                  tracers::SpanEdgeSigVerif,
+                                  delay - verif_start );
+            if( valid )
             {
                 // if signature is valid then set auth validity
                 // and put auth into positive cache
@@ -186,6 +239,12 @@ EdgeStrategy::filterOutgoingInterest
                 tracers::edge->auth_cached
                 ( auth, tracers::CachedPositiveMoved );
                 m_positive_cache.insert( auth );
+                
+                // and remove it from the negative cache so it
+                // doesn't need to be verified again if it falls
+                // out of the positive cache
+                if( m_negative_cache.erase( auth ) )
+                    delay += m_config.bloom_delay;
             }
             else
             {
@@ -207,25 +266,25 @@ EdgeStrategy::filterOutgoingInterest
 }
 
 void
-EdgeStrategy::toNack( ndn::Data& data, const ndn::Interest& interest )
+EdgeStrategy::toNack( nfd::fw::OutgoingData& data,
+                      const ndn::Interest& interest )
 {
     // ensure that denied data doesn't leave the network
-    data.setContent( ndn::Block() );
-    data.wireEncode();
+    data.modify().setContent( ndn::Block() );
     
     // do whatever a normal router would do
     RouterStrategy::toNack( data, interest );
 }
 
 void
-EdgeStrategy::toPreserve( ndn::Data& data,
+EdgeStrategy::toPreserve( nfd::fw::OutgoingData& data,
                           const ndn::Interest& interest )
 {
-    if( data.getContentType() == ndn::tlv::ContentType_Nack )
-    {
-        data.setContent( ndn::Block() );
-        data.wireEncode();
-    }
+    // nacks are usually already emptied upstream,
+    // in which case the data can stay shared
+    if( data.get().getContentType() == ndn::tlv::ContentType_Nack
+      && data.get().getContent().value_size() > 0 )
+        data.modify().setContent( ndn::Block() );
 }
 
 void
@@ -268,8 +327,8 @@ EdgeStrategy::onDataDenied
     {
         BOOST_ASSERT( interest.hasAuthTag() );
         tracers::edge->bloom_insert
-        ( interest.getAuthTag(), s_edge_bloom_delay );
-        delay += s_edge_bloom_delay;
+        ( interest.getAuthTag(), m_config.bloom_delay );
+        delay += m_config.bloom_delay;
         m_negative_cache.insert( interest.getAuthTag() );
     }
 
@@ -314,8 +373,8 @@ EdgeStrategy::onDataSatisfied
     {
         BOOST_ASSERT( interest.hasAuthTag() );
         tracers::edge->bloom_insert
-        ( interest.getAuthTag(), s_edge_bloom_delay );
-        delay += s_edge_bloom_delay;
+        ( interest.getAuthTag(), m_config.bloom_delay );
+        delay += m_config.bloom_delay;
         m_positive_cache.insert( interest.getAuthTag() );
     }
     
@@ -33,10 +33,12 @@ namespace ndntac
       EdgeStrategy( nfd::Forwarder& forwarder,
                       const ndn::Name& name = STRATEGY_NAME );
 
+      using RouterStrategy::filterOutgoingData;
+
       bool
       filterOutgoingData( const nfd::Face& face,
                           const ndn::Interest& interest,
-                          ndn::Data& data,
+                          nfd::fw::OutgoingData& data,
                           ns3::Time& delay ) override;
       
       bool
@@ -56,10 +58,12 @@ namespace ndntac
                        ns3::Time& delay ) override;
       
       void
-      toNack( ndn::Data& data, const ndn::Interest& interest ) override;
+      toNack( nfd::fw::OutgoingData& data,
+              const ndn::Interest& interest ) override;
 
       void
-      toPreserve( ndn::Data& data, const ndn::Interest& interest ) override;  
+      toPreserve( nfd::fw::OutgoingData& data,
+                  const ndn::Interest& interest ) override;  
 
     public:
        static std::string s_config;
@@ -67,9 +71,6 @@ namespace ndntac
     private:
             AuthCache   m_positive_cache;
             AuthCache   m_negative_cache;
-
-            static const ns3::Time s_edge_signature_delay;
-            static const ns3::Time s_edge_bloom_delay;
     };
 
 };
@@ -0,0 +1,255 @@
+/**
+* @class ndntac::ExactAuthCache
+* An exact cache of AuthTags, with no false positives.
+*
+* Tags are kept in an open addressing ( linear probing ) hash table
+* keyed by the tag's fingerprint, along with their expiration time.
+* Entries are evicted by a timing wheel once their tags expire, so a
+* hit always refers to an unexpired tag.  The table is allocated once for the configured
+* number of tags, inserts into a full table are dropped.
+*
+* Costs a few tens of bytes per tag, so it's meant for edge routers
+* where memory isn't the bottleneck.
+**/
+
+#ifndef EXACT_AUTH_CACHE_INCLUDED
+#define EXACT_AUTH_CACHE_INCLUDED
+
+#include "ndn-cxx/auth-tag.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ndntac
+{
+
+  class ExactAuthCache
+  {
+  public:
+    struct Entry
+    {
+      uint64_t fingerprint[2];
+
+      // expiration in milliseconds since the epoch,
+      // INT64_MAX for tags without a validity period
+      int64_t  expiration;
+      bool     used;
+    };
+
+    // resolution and span of the timing wheel, tags that expire
+    // beyond the span wait in their slot for further rotations
+    static const int64_t WHEEL_TICK = 1000;
+    static const size_t  WHEEL_SLOTS = 256;
+
+  private:
+    struct WheelRef
+    {
+      uint64_t fingerprint[2];
+      int64_t  expiration;
+    };
+
+    std::vector< Entry >                   m_table;
+    uint64_t                               m_mask;
+    size_t                                 m_size;
+    size_t                                 m_max_size;
+
+    std::vector< std::vector< WheelRef > > m_wheel;
+    int64_t                                m_wheel_tick;
+
+  public:
+
+    /**
+    * @brief Constructor
+    * @param n  Max number of tags to be stored in the cache
+    **/
+    ExactAuthCache( uint32_t n )
+      : m_size( 0 )
+      , m_max_size( std::max( n, (uint32_t)1 ) )
+      , m_wheel( WHEEL_SLOTS )
+      , m_wheel_tick( now()/WHEEL_TICK )
+    {
+      // keep the load factor at or below 1/2 so probe
+      // sequences stay short
+      uint64_t capacity = 1;
+      while( capacity < 2*m_max_size )
+        capacity <<= 1;
+      m_table.resize( capacity );
+      m_mask = capacity - 1;
+      for( Entry& entry : m_table )
+        entry.used = false;
+    }
+
+    /**
+    * @brief Insert a tag into the cache
+    * @param tag  Tag to insert
+    **/
+    void insert( const ndn::AuthTag& tag )
+    {
+      advance();
+
+      const uint64_t* fp = tag.getFingerprint();
+      uint64_t i = probe( fp );
+      if( m_table[i].used )
+        return;
+      if( m_size >= m_max_size )
+        return;
+
+      int64_t expiration = INT64_MAX;
+      try
+      {
+        expiration = ndn::time::toUnixTimestamp
+                     ( tag.getExpirationTime() ).count();
+      }
+      catch( ... )
+      {
+        // tags without a validity period never expire
+      }
+
+      Entry& entry = m_table[i];
+      entry.fingerprint[0] = fp[0];
+      entry.fingerprint[1] = fp[1];
+      entry.expiration = expiration;
+      entry.used = true;
+      m_size++;
+
+      if( expiration != INT64_MAX )
+      {
+        int64_t tick = std::max( expiration/WHEEL_TICK, m_wheel_tick );
+        m_wheel[ tick % WHEEL_SLOTS ].push_back
+          ( WheelRef{ { fp[0], fp[1] }, expiration } );
+      }
+    }
+
+    /**
+    * @brief Find the cache entry for a tag
+    * @param tag  Tag to look for
+    * @return The tag's entry, or nullptr if the tag isn't cached
+    *         or has expired
+    **/
+    const Entry* find( const ndn::AuthTag& tag )
+    {
+      advance();
+
+      const Entry& entry = m_table[ probe( tag.getFingerprint() ) ];
+      if( !entry.used || entry.expiration < now() )
+        return nullptr;
+      return &entry;
+    }
+
+    /**
+    * @brief Check for a tag in the cache
+    * @param tag  Tag to check for
+    * @return true if the tag is cached and unexpired
+    **/
+    bool contains( const ndn::AuthTag& tag )
+    {
+      return find( tag ) != nullptr;
+    }
+
+    /**
+    * @brief Erase a tag from the cache
+    * @param tag  Tag to erase
+    * @return true if the tag was in the cache
+    **/
+    bool erase( const ndn::AuthTag& tag )
+    {
+      return erase( tag.getFingerprint() );
+    }
+
+    size_t size() const
+    {
+      return m_size;
+    }
+
+  private:
+
+    /**
+    * @brief Find the slot holding a fingerprint, or the empty
+    *        slot where it would be inserted
+    **/
+    uint64_t probe( const uint64_t* fp ) const
+    {
+      uint64_t i = fp[0] & m_mask;
+      while( m_table[i].used
+           && ( m_table[i].fingerprint[0] != fp[0]
+             || m_table[i].fingerprint[1] != fp[1] ) )
+      {
+        i = ( i + 1 ) & m_mask;
+      }
+      return i;
+    }
+
+    bool erase( const uint64_t* fp )
+    {
+      uint64_t i = probe( fp );
+      if( !m_table[i].used )
+        return false;
+
+      // shift later entries of the probe sequence back into
+      // the hole, so lookups never need tombstones
+      uint64_t j = i;
+      while( true )
+      {
+        j = ( j + 1 ) & m_mask;
+        if( !m_table[j].used )
+          break;
+        uint64_t home = m_table[j].fingerprint[0] & m_mask;
+        if( ( ( j - home ) & m_mask ) >= ( ( j - i ) & m_mask ) )
+        {
+          m_table[i] = m_table[j];
+          i = j;
+        }
+      }
+      m_table[i].used = false;
+      m_size--;
+      return true;
+    }
+
+    /**
+    * @brief Rotate the timing wheel up to the current time,
+    *        evicting all tags that have expired
+    **/
+    void advance()
+    {
+      int64_t now_ms = now();
+      int64_t now_tick = now_ms/WHEEL_TICK;
+
+      // only fully elapsed ticks are processed, so every tag in
+      // the slot that expires within the tick has expired; a full
+      // rotation visits every slot, no need to go further
+      int64_t from = std::max( m_wheel_tick,
+                               now_tick - (int64_t)WHEEL_SLOTS );
+      for( int64_t tick = from ; tick < now_tick ; tick++ )
+      {
+        std::vector< WheelRef >& slot = m_wheel[ tick % WHEEL_SLOTS ];
+        size_t kept = 0;
+        for( size_t i = 0 ; i < slot.size() ; i++ )
+        {
+          const WheelRef& ref = slot[i];
+          if( ref.expiration >= now_ms )
+          {
+            slot[kept++] = ref;
+            continue;
+          }
+
+          // the tag may have been erased, or erased and re-inserted,
+          // since it was put on the wheel
+          const Entry& entry = m_table[ probe( ref.fingerprint ) ];
+          if( entry.used && entry.expiration == ref.expiration )
+            erase( ref.fingerprint );
+        }
+        slot.resize( kept );
+      }
+      m_wheel_tick = std::max( m_wheel_tick, now_tick );
+    }
+
+    static int64_t now()
+    {
+      return ndn::time::toUnixTimestamp
+             ( ndn::time::system_clock::now() ).count();
+    }
+  };
+
+};
+
+#endif // EXACT_AUTH_CACHE_INCLUDED
@@ -0,0 +1,147 @@
+/**
+* @class ndntac::KeyContextCache
+* A cache of the per key state a node needs to verify signatures.
+*
+* Before a node can verify a signature it has to load the context of
+* the signing key, i.e. parse the key, build its verification tables
+* and decide whether the key is trusted.  The cache remembers the
+* contexts of recently used keys, keyed by their locator, so a node
+* only pays for loading a key on a miss.  When the cache
+* is full the least recently used context is evicted.
+*
+* One cache is shared by all strategies on a node, see forNode.
+**/
+
+#ifndef KEY_CONTEXT_CACHE_INCLUDED
+#define KEY_CONTEXT_CACHE_INCLUDED
+
+#include "ndn-cxx/key-locator.hpp"
+#include <boost/functional/hash.hpp>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace ndntac
+{
+
+  class KeyContextCache
+  {
+  public:
+    struct Context
+    {
+      bool trusted;
+    };
+
+  private:
+    struct Entry
+    {
+      ndn::KeyLocator locator;
+      Context         context;
+    };
+
+    struct KeyLocatorHash
+    {
+      size_t operator()( const ndn::KeyLocator& locator ) const
+      {
+        const ndn::Block& wire = locator.wireEncode();
+        return boost::hash_range( wire.wire(), wire.wire() + wire.size() );
+      }
+    };
+
+    // most recently used first; the index compares whole
+    // locators, so keys with colliding hashes stay apart
+    std::list< Entry >                            m_entries;
+    std::unordered_map< ndn::KeyLocator,
+                        std::list< Entry >::iterator,
+                        KeyLocatorHash >          m_index;
+    size_t                                        m_max_size;
+
+  public:
+
+    /**
+    * @brief Constructor
+    * @param n  Max number of contexts, at least one is kept
+    **/
+    KeyContextCache( size_t n )
+      : m_max_size( std::max( n, (size_t)1 ) )
+    { }
+
+    /**
+    * @brief Get the cache of a node, creating it if it doesn't exist
+    *
+    * The cache lives as long as a strategy on the node holds it.
+    *
+    * @param node_id  Id of the node
+    * @param n        Max number of contexts, if the cache is created
+    **/
+    static std::shared_ptr< KeyContextCache >
+    forNode( uint32_t node_id, size_t n )
+    {
+      static std::map< uint32_t,
+                       std::weak_ptr< KeyContextCache > > caches;
+
+      // drop the entries of caches whose strategies are all gone
+      for( auto it = caches.begin() ; it != caches.end() ; )
+      {
+        if( it->second.expired() )
+          it = caches.erase( it );
+        else
+          it++;
+      }
+
+      std::shared_ptr< KeyContextCache > cache = caches[ node_id ].lock();
+      if( !cache )
+      {
+        cache = std::make_shared< KeyContextCache >( n );
+        caches[ node_id ] = cache;
+      }
+      return cache;
+    }
+
+    /**
+    * @brief Find the context of a key, marking it as recently used
+    * @return The context, or nullptr if it isn't cached
+    **/
+    const Context* find( const ndn::KeyLocator& locator )
+    {
+      auto it = m_index.find( locator );
+      if( it == m_index.end() )
+        return nullptr;
+
+      m_entries.splice( m_entries.begin(), m_entries, it->second );
+      return &it->second->context;
+    }
+
+    /**
+    * @brief Insert or replace the context of a key
+    **/
+    void insert( const ndn::KeyLocator& locator, const Context& context )
+    {
+      auto it = m_index.find( locator );
+      if( it != m_index.end() )
+      {
+        it->second->context = context;
+        m_entries.splice( m_entries.begin(), m_entries, it->second );
+        return;
+      }
+
+      if( m_entries.size() >= m_max_size )
+      {
+        m_index.erase( m_entries.back().locator );
+        m_entries.pop_back();
+      }
+      m_entries.push_front( Entry{ locator, context } );
+      m_index[ locator ] = m_entries.begin();
+    }
+
+    size_t size() const
+    {
+      return m_entries.size();
+    }
+  };
+
+};
+
+#endif // KEY_CONTEXT_CACHE_INCLUDED
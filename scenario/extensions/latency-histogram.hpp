@@ -0,0 +1,134 @@
+/**
+* @class ndntac::tracers::LatencyHistogram
+* A log bucketed histogram of latencies, in the style of HdrHistogram.
+*
+* Values are non-negative nanoseconds.  Each power of two range of
+* values is split into the same number of linear sub-buckets, so
+* every recorded value is kept to within 1/64 of its magnitude, and
+* the histogram has a fixed number of buckets regardless of the range
+* or count of values recorded.  Histograms can be merged by adding
+* their buckets, so per consumer histograms can be combined into a
+* network wide one.
+**/
+
+#ifndef LATENCY_HISTOGRAM_INCLUDED
+#define LATENCY_HISTOGRAM_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ndntac
+{
+namespace tracers
+{
+
+  class LatencyHistogram
+  {
+  private:
+    // values below SUB_BUCKETS get a bucket each, above that each
+    // power of two gets HALF_BUCKETS buckets
+    static const int      SUB_BUCKET_BITS = 7;
+    static const int64_t  SUB_BUCKETS     = 1 << SUB_BUCKET_BITS;
+    static const int64_t  HALF_BUCKETS    = SUB_BUCKETS/2;
+    static const size_t   BUCKETS         = SUB_BUCKETS
+                                          + ( 63 - SUB_BUCKET_BITS )
+                                            *HALF_BUCKETS;
+
+    std::vector< uint64_t > m_counts;
+    uint64_t                m_total = 0;
+
+  public:
+    LatencyHistogram()
+      : m_counts( BUCKETS, 0 )
+    { }
+
+    /**
+    * @brief Record a latency in nanoseconds, negative values
+    *        are recorded as 0
+    **/
+    void record( int64_t value )
+    {
+      m_counts[ bucketOf( value < 0 ? 0 : value ) ]++;
+      m_total++;
+    }
+
+    /**
+    * @brief Add all values recorded in another histogram
+    **/
+    void merge( const LatencyHistogram& other )
+    {
+      for( size_t i = 0 ; i < BUCKETS ; i++ )
+        m_counts[i] += other.m_counts[i];
+      m_total += other.m_total;
+    }
+
+    void reset()
+    {
+      std::fill( m_counts.begin(), m_counts.end(), 0 );
+      m_total = 0;
+    }
+
+    uint64_t count() const
+    {
+      return m_total;
+    }
+
+    /**
+    * @brief Get the value at a percentile
+    * @param percentile  Between 0 and 100
+    * @return The highest value that falls in the same bucket
+    *         as the percentile, or 0 if nothing was recorded
+    **/
+    int64_t percentile( double percentile ) const
+    {
+      if( m_total == 0 )
+        return 0;
+
+      // rank of the value, at least the first one
+      uint64_t rank = percentile/100.0*m_total + 0.5;
+      if( rank < 1 )
+        rank = 1;
+      if( rank > m_total )
+        rank = m_total;
+
+      uint64_t seen = 0;
+      for( size_t i = 0 ; i < BUCKETS ; i++ )
+      {
+        seen += m_counts[i];
+        if( seen >= rank )
+          return highestValueOf( i );
+      }
+      return highestValueOf( BUCKETS - 1 );
+    }
+
+  private:
+
+    static size_t bucketOf( int64_t value )
+    {
+      if( value < SUB_BUCKETS )
+        return value;
+
+      // shift so the value's top SUB_BUCKET_BITS - 1 bits remain,
+      // which puts it in [ HALF_BUCKETS, SUB_BUCKETS )
+      int msb = 63 - __builtin_clzll( value );
+      int shift = msb - ( SUB_BUCKET_BITS - 1 );
+      return SUB_BUCKETS + ( shift - 1 )*HALF_BUCKETS
+           + ( ( value >> shift ) - HALF_BUCKETS );
+    }
+
+    static int64_t highestValueOf( size_t bucket )
+    {
+      if( (int64_t)bucket < SUB_BUCKETS )
+        return bucket;
+
+      int shift = ( bucket - SUB_BUCKETS )/HALF_BUCKETS + 1;
+      uint64_t sub = ( bucket - SUB_BUCKETS )%HALF_BUCKETS + HALF_BUCKETS;
+      return ( ( sub + 1 ) << shift ) - 1;
+    }
+  };
+
+};
+};
+
+#endif // LATENCY_HISTOGRAM_INCLUDED
@@ -0,0 +1,272 @@
+/**
+* @class ndntac::tracers::MetricsStore
+* Counters recorded by the tracers, kept per node, face and role.
+*
+* Each distinct ( node, face, role ) gets a row the first time a
+* metric is recorded for it; the node is the simulator context the
+* metric is recorded in.  Rows are stored as columns, one array of
+* values per metric, so sampling a metric across all rows is a linear
+* scan.  Totals over all rows are kept alongside, for the tracers
+* that only log network wide values.
+*
+* Delays are recorded in nanoseconds.
+**/
+
+#ifndef METRICS_INCLUDED
+#define METRICS_INCLUDED
+
+#include "ns3/core-module.h"
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace ndntac
+{
+namespace tracers
+{
+
+  enum Metric
+  {
+    MetricTagsCreated,
+    MetricTagsActive,
+    MetricInterestsTransmitted,
+    MetricDatasTransmitted,
+    MetricTagsTransmitted,
+    MetricInterestBytesTransmitted,
+    MetricDataBytesTransmitted,
+    MetricTagBytesTransmitted,
+    MetricSigverifs,
+    MetricSigverifsDelay,
+    MetricKeyContextHits,
+    MetricKeyContextMisses,
+    MetricKeyContextDelay,
+    MetricBloomLookups,
+    MetricBloomLookupsDelay,
+    MetricBloomInserts,
+    MetricBloomInsertsDelay,
+    MetricPositiveCacheHits,
+    MetricPositiveCacheMisses,
+    MetricNegativeCacheHits,
+    MetricNegativeCacheMisses,
+    MetricValidationsSuccessValProb,
+    MetricValidationsSuccessBloom,
+    MetricValidationsSuccessSig,
+    MetricValidationsSuccessSkipped,
+    MetricValidationsSuccessMemo,
+    MetricValidationsFailureSig,
+    MetricValidationsFailureNoAuth,
+    MetricValidationsFailureLowAuth,
+    MetricValidationsFailureBadKeyLoc,
+    MetricValidationsFailureExpired,
+    MetricValidationsFailureBadPrefix,
+    MetricValidationsFailureBadRoute,
+    MetricAuthCachedPositiveUpstream,
+    MetricAuthCachedPositiveMoved,
+    MetricAuthCachedNegativeUpstream,
+    MetricEdgeBlockedExpired,
+    MetricEdgeBlockedBadPrefix,
+    MetricEdgeBlockedBadRoute,
+    MetricConsumerDenied,
+    MetricConsumerDeserved,
+    MetricConsumerUndeserved,
+    MetricConsumerUnrequested,
+    MetricConsumerRetx,
+    MetricConsumerTimeout,
+    MetricConsumerReceived,
+    MetricConsumerRequested,
+    MetricConsumerPartialDelay,
+    MetricConsumerDelay,
+    MetricCount
+  };
+
+  enum Role
+  {
+    RoleProducer,
+    RoleConsumer,
+    RoleRouter,
+    RoleEdge,
+    RoleCount
+  };
+
+  class MetricsStore
+  {
+  public:
+    // face of metrics that aren't related to a face
+    static const uint64_t NO_FACE = UINT64_MAX;
+
+  private:
+    struct Row
+    {
+      uint32_t node;
+      uint64_t face;
+      Role     role;
+
+      bool operator==( const Row& other ) const
+      {
+        return node == other.node
+            && face == other.face
+            && role == other.role;
+      }
+    };
+
+    struct RowHash
+    {
+      size_t operator()( const Row& row ) const
+      {
+        return ( (size_t)row.node*RoleCount + row.role )*31
+             + (size_t)row.face;
+      }
+    };
+
+    std::vector< Row >                            m_rows;
+    std::unordered_map< Row, size_t, RowHash >    m_row_index;
+    std::vector< int64_t >                        m_columns[MetricCount];
+    int64_t                                       m_totals[MetricCount] = {};
+
+  public:
+
+    /**
+    * @brief Add to a metric of the current node
+    * @param role    Role the metric is recorded for
+    * @param metric  Metric to add to
+    * @param value   Amount to add, may be negative
+    * @param face    Face the metric is recorded for, if any
+    **/
+    void record( Role role, Metric metric,
+                 int64_t value = 1, uint64_t face = NO_FACE )
+    {
+      m_columns[metric][ findRow( role, face ) ] += value;
+      m_totals[metric] += value;
+    }
+
+    /**
+    * @brief Get the total of a metric over all rows
+    **/
+    int64_t total( Metric metric ) const
+    {
+      return m_totals[metric];
+    }
+
+    /**
+    * @brief Preallocate the columns for n rows
+    **/
+    void reserve( size_t n )
+    {
+      m_rows.reserve( n );
+      m_row_index.reserve( n );
+      for( size_t i = 0 ; i < MetricCount ; i++ )
+        m_columns[i].reserve( n );
+    }
+
+    /**
+    * @brief Write the csv column names
+    **/
+    void writeHeader( std::ostream& os ) const
+    {
+      os << "time,node,face,role";
+      for( size_t i = 0 ; i < MetricCount ; i++ )
+        os << ',' << metricName( (Metric)i );
+      os << '\n';
+    }
+
+    /**
+    * @brief Write the current value of every row as csv,
+    *        faceless rows have an empty face column
+    **/
+    void writeSample( std::ostream& os, ns3::Time now ) const
+    {
+      static const char* roles[RoleCount] =
+        { "producer", "consumer", "router", "edge" };
+
+      for( size_t row = 0 ; row < m_rows.size() ; row++ )
+      {
+        os << now.GetSeconds() << ',' << m_rows[row].node << ',';
+        if( m_rows[row].face != NO_FACE )
+          os << m_rows[row].face;
+        os << ',' << roles[ m_rows[row].role ];
+        for( size_t i = 0 ; i < MetricCount ; i++ )
+          os << ',' << m_columns[i][row];
+        os << '\n';
+      }
+    }
+
+    static const char* metricName( Metric metric )
+    {
+      static const char* names[MetricCount] =
+      {
+        "tags_created",
+        "tags_active",
+        "interests_transmitted",
+        "datas_transmitted",
+        "tags_transmitted",
+        "interest_bytes_transmitted",
+        "data_bytes_transmitted",
+        "tag_bytes_transmitted",
+        "sigverifs",
+        "sigverifs_delay",
+        "key_context_hits",
+        "key_context_misses",
+        "key_context_delay",
+        "bloom_lookups",
+        "bloom_lookups_delay",
+        "bloom_inserts",
+        "bloom_inserts_delay",
+        "positive_cache_hits",
+        "positive_cache_misses",
+        "negative_cache_hits",
+        "negative_cache_misses",
+        "validations_success_valprob",
+        "validations_success_bloom",
+        "validations_success_sig",
+        "validations_success_skipped",
+        "validations_success_memo",
+        "validations_failure_sig",
+        "validations_failure_noauth",
+        "validations_failure_lowauth",
+        "validations_failure_badkeyloc",
+        "validations_failure_expired",
+        "validations_failure_badprefix",
+        "validations_failure_badroute",
+        "authcached_positive_upstream",
+        "authcached_positive_moved",
+        "authcached_negative_upstream",
+        "edge_blocked_expired",
+        "edge_blocked_bad_prefix",
+        "edge_blocked_bad_route",
+        "consumer_denied",
+        "consumer_deserved",
+        "consumer_undeserved",
+        "consumer_unrequested",
+        "consumer_retx",
+        "consumer_timeout",
+        "consumer_received",
+        "consumer_requested",
+        "consumer_partial_delay",
+        "consumer_delay"
+      };
+      return names[metric];
+    }
+
+  private:
+
+    size_t findRow( Role role, uint64_t face )
+    {
+      Row key{ ns3::Simulator::GetContext(), face, role };
+      auto it = m_row_index.find( key );
+      if( it != m_row_index.end() )
+        return it->second;
+
+      size_t row = m_rows.size();
+      m_rows.push_back( key );
+      m_row_index.emplace( key, row );
+      for( size_t i = 0 ; i < MetricCount ; i++ )
+        m_columns[i].push_back( 0 );
+      return row;
+    }
+  };
+
+};
+};
+
+#endif // METRICS_INCLUDED
@@ -156,7 +156,7 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
     tracers::producer->validation
     ( tracers::ValidationSuccessSkipped );
     tracers::producer->sent_data( *data );
-    m_tx_queue.receiveData( m_face, data );
+    m_tx_queue.receiveData( m_face, data, interest->getNonce() );
   }
   
   // interests without tags are refused
@@ -166,7 +166,7 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
     ( tracers::ValidationFailureNoAuth );
     toNack( *data );
     tracers::producer->sent_data( *data );
-    m_tx_queue.receiveData( m_face, data );
+    m_tx_queue.receiveData( m_face, data, interest->getNonce() );
     return;
   }
   
@@ -180,7 +180,7 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
     ( tracers::ValidationFailureLowAuth );
     toNack( *data );
     tracers::producer->sent_data( *data );
-    m_tx_queue.receiveData( m_face, data );
+    m_tx_queue.receiveData( m_face, data, interest->getNonce() );
     return;
   }
 
@@ -192,7 +192,7 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
     ( tracers::ValidationFailureExpired );
     toNack( *data );
     tracers::producer->sent_data( *data );
-    m_tx_queue.receiveData( m_face, data );
+    m_tx_queue.receiveData( m_face, data, interest->getNonce() );
     return;
   }
 
@@ -203,7 +203,7 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
     ( tracers::ValidationFailureBadPrefix );
     toNack( *data );
     tracers::producer->sent_data( *data );
-    m_tx_queue.receiveData( m_face, data );
+    m_tx_queue.receiveData( m_face, data, interest->getNonce() );
     return;
   }
 
@@ -214,7 +214,7 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
     ( tracers::ValidationFailureBadKeyLoc );
     toNack( *data );
     tracers::producer->sent_data( *data );
-    m_tx_queue.receiveData( m_face, data );
+    m_tx_queue.receiveData( m_face, data, interest->getNonce() );
     return;
   }
   if( tag.getKeyLocator() != data->getSignature().getKeyLocator() )
@@ -223,7 +223,7 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
     ( tracers::ValidationFailureBadKeyLoc );
     toNack( *data );
     tracers::producer->sent_data( *data );
-    m_tx_queue.receiveData( m_face, data );
+    m_tx_queue.receiveData( m_face, data, interest->getNonce() );
     return;
   }
 
@@ -234,7 +234,7 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
     ( tracers::ValidationFailureBadRoute );
     toNack( *data );
     tracers::producer->sent_data( *data );
-    m_tx_queue.receiveData( m_face, data );
+    m_tx_queue.receiveData( m_face, data, interest->getNonce() );
     return;
   }
 
@@ -246,19 +246,24 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
 
 
   // verify signature, we simulate actual verification delay by
-  // adding delay to the transmit queue, signature is valid if it
-  // isn't equal to DUMMY_BAD_SIGNATURE, which has 0 as its first
-  // byte
+  // adding delay to the transmit queue; a dummy signature is valid
+  // if it isn't equal to DUMMY_BAD_SIGNATURE, which has 0 as its
+  // first byte, a real signature is actually verified and its
+  // delay is the time that took
+  Time sigverif_delay = m_config.sigverif_delay;
+  bool valid = SignatureVerifier::get().verify
+               ( tag, m_config.signature_mode, sigverif_delay );
   tracers::producer->sigverif
-  ( tag, m_config.sigverif_delay );
-  m_tx_queue.delay( m_config.sigverif_delay );
-  if( tag.getSignature().getValue().value_size() > 0
-      && tag.getSignature().getValue().value()[0] != 0 )
+  ( tag, sigverif_delay );
+  tracers::spans->span( interest->getNonce(), tracers::SpanProducerSigVerif,
+                        sigverif_delay );
+  m_tx_queue.delay( sigverif_delay );
+  if( valid )
   {
     tracers::producer->validation
     ( tracers::ValidationSuccessSig );
     tracers::producer->sent_data( *data );
-    m_tx_queue.receiveData( m_face, data );
+    m_tx_queue.receiveData( m_face, data, interest->getNonce() );
     return;
   }
 
@@ -267,7 +272,7 @@ Producer::onDataRequest( shared_ptr< const Interest > interest )
   ( tracers::ValidationFailureSig );
   toNack( *data );
   tracers::producer->sent_data( *data );
-  m_tx_queue.receiveData( m_face, data );
+  m_tx_queue.receiveData( m_face, data, interest->getNonce() );
 }
 
 void
@@ -294,6 +299,8 @@ Producer::onAuthRequest( shared_ptr< const Interest > interest )
   Signature sig = security::DUMMY_NDN_SIGNATURE;
   sig.setKeyLocator( KeyLocator( m_config.prefix ) );
   tag.setSignature( sig );
+  SignatureVerifier::get().sign( tag, m_config.signature_mode,
+                                 m_config.signature_key_size );
 
   auto data = make_shared< Data >( interest->getName() );
   data->setContentType( tlv::ContentType_Auth );
@@ -307,7 +314,7 @@ Producer::onAuthRequest( shared_ptr< const Interest > interest )
               ==  RouteTracker::EXIT_NETWORK );
   
   tracers::producer->sent_data( *data );
-  m_tx_queue.receiveData( m_face, data );
+  m_tx_queue.receiveData( m_face, data, interest->getNonce() );
 }
 
 void
@@ -359,6 +366,8 @@ Producer::Config::Config( const string& file, uint32_t id )
     prefix = Name("unnamed");
     sigverif_delay = NanoSeconds( 30345 );
     bloom_delay    = NanoSeconds( 2535 );
+    signature_mode = SignatureVerifier::DummySignatures;
+    signature_key_size = 2048;
     
     // database and vm structs
     unqlite* db;
@@ -447,6 +456,17 @@ Producer::Config::Config( const string& file, uint32_t id )
        bloom_delay = Seconds( unqlite_value_to_double( val ) );
     if( unqlite_value_is_int( val ) )
         bloom_delay = Seconds( unqlite_value_to_int64( val ) );
+
+    val = unqlite_vm_extract_variable( vm, "signature_mode" );
+    if( val && unqlite_value_is_string( val ) )
+    {
+        str = unqlite_value_to_string( val, &len );
+        signature_mode = SignatureVerifier::parseMode( string( str, len ) );
+    }
+
+    val = unqlite_vm_extract_variable( vm, "signature_key_size" );
+    if( val && unqlite_value_is_int( val ) )
+        signature_key_size = unqlite_value_to_int64( val );
  
     val = unqlite_vm_extract_variable( vm, "contents" );
     if( val && unqlite_value_is_json_array( val ) )
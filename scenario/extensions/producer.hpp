@@ -23,6 +23,7 @@
 #include "ndn-cxx/auth-tag.hpp"
 #include "ndn-cxx/encoding/tlv.hpp"
 #include "auth-cache.hpp"
+#include "signature-verifier.hpp"
 #include "unqlite.hpp"
 #include <memory>
 
@@ -89,9 +90,15 @@ namespace ndntac
             // producer prefix
             ndn::Name prefix;
             
-            // delay for each signature verification
+            // delay for each signature verification, only
+            // used with dummy signatures
             ns3::Time sigverif_delay;
             
+            // dummy or real signatures, and the size of the
+            // real signing key
+            SignatureVerifier::Mode signature_mode;
+            uint32_t signature_key_size;
+            
             // delay for each bloom loockup
             ns3::Time bloom_delay;
         };
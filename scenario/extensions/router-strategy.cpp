@@ -1,10 +1,36 @@
 #include "router-strategy.hpp"
 #include "ns3/ndnSIM/utils/dummy-keychain.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/node-list.h"
 #include "tracers.hpp"
+#include "unqlite.hpp"
+#include <iostream>
 
 namespace ndntac
 {
 
+namespace
+{
+
+// finds the id of the node a forwarder belongs to, strategies are
+// installed from outside the node's context so this can't come
+// from the simulator
+uint32_t
+nodeIdOf( const nfd::Forwarder& forwarder )
+{
+    for( uint32_t i = 0 ; i < ns3::NodeList::GetNNodes() ; i++ )
+    {
+        auto l3 = ns3::NodeList::GetNode( i )
+                  ->GetObject< ns3::ndn::L3Protocol >();
+        if( l3 && l3->getForwarder().get() == &forwarder )
+            return i;
+    }
+    BOOST_ASSERT( false );
+    return ns3::NodeList::GetNNodes();
+}
+
+}
+
 uint32_t
 RouterStrategy::s_instance_id = 0;
 
@@ -12,27 +38,40 @@ const ndn::Name
 RouterStrategy::STRATEGY_NAME = "ndn:/localhost/nfd/strategy/ndntac-router-strategy";
 string
 RouterStrategy::s_config = "config/router_config.jx9";
-const ns3::Time
-RouterStrategy::s_router_signature_delay = ns3::NanoSeconds( 30345 );
-const ns3::Time
-RouterStrategy::s_router_bloom_delay = ns3::NanoSeconds( 2535 );
-const ns3::Time
-RouterStrategy::s_router_interest_delay = ns3::MilliSeconds( 0 );
 
 RouterStrategy::RouterStrategy( nfd::Forwarder& forwarder,
                               const ndn::Name& name )
+                                : RouterStrategy( forwarder, name, s_config )
+{ }
+
+RouterStrategy::RouterStrategy( nfd::Forwarder& forwarder,
+                              const ndn::Name& name,
+                              const std::string& config )
                                 : BestRouteStrategy( forwarder, name )
-                                , m_auth_cache( 1e-10, 10000 )
+                                , m_instance_id( s_instance_id++ )
+                                , m_config( config, m_instance_id )
+                                , m_auth_cache
+                                  ( m_config.auth_cache.fpp,
+                                    m_config.auth_cache.size,
+                                    m_config.auth_cache.generations,
+                                    m_config.auth_cache.backend )
+                                , m_validation_memo
+                                  ( m_config.validation_memo_size )
+                                , m_key_contexts
+                                  ( KeyContextCache::forNode
+                                    ( nodeIdOf( forwarder ),
+                                      m_config.key_context_cache_size ) )
                                 , m_forwarder( forwarder )
 {
-    m_instance_id = s_instance_id++;
+    if( m_config.signature_mode != SignatureVerifier::DummySignatures )
+        SignatureVerifier::get().reserveThreads( m_config.sigverif_threads );
 }
   
 bool
 RouterStrategy::filterOutgoingData
 ( const nfd::Face& face,
   const ndn::Interest& interest,
-  ndn::Data& data,
+  nfd::fw::OutgoingData& data,
   ns3::Time& delay )
 {   
 
@@ -44,29 +83,29 @@ RouterStrategy::filterOutgoingData
     // and the interest RouteTracker should be transfered to the
     // data it retrieves, we can check if the data was retrieved
     // by this interest by comparing all three hashes
-    if( data.getExitRoute() == interest.getExitRoute()
-      && data.getInternetRoute() == interest.getInternetRoute()
-      && data.getEntryRoute() == interest.getEntryRoute() )
+    if( data.get().getExitRoute() == interest.getExitRoute()
+      && data.get().getInternetRoute() == interest.getInternetRoute()
+      && data.get().getEntryRoute() == interest.getEntryRoute() )
     {
        toPreserve( data, interest );
-       onDataPreserved( data, interest, delay );
-       tracers::router->sent_data( data );
+       onDataPreserved( data.get(), interest, delay );
+       tracers::router->sent_data( data.get() );
        return true;
     }
     
     // we replace the data's route tracker with
     // that of its requesting interest
-    data.setRouteTracker( interest.getRouteTracker() );
+    data.modify().setRouteTracker( interest.getRouteTracker() );
 
     // if the data's access level is 0 (public)
     // then forward without authenticating
-    if( data.getAccessLevel() == 0 )
+    if( data.get().getAccessLevel() == 0 )
     {
         toSatisfy( data, interest );
-        onDataSatisfied( data, interest, delay );
+        onDataSatisfied( data.get(), interest, delay );
         tracers::router->validation
         ( tracers::ValidationSuccessSkipped );
-        tracers::router->sent_data( data );
+        tracers::router->sent_data( data.get() );
         return true;
     }
     
@@ -74,10 +113,10 @@ RouterStrategy::filterOutgoingData
     if( interest.hasAuthTag() == false )
     {
         toNack( data, interest );
-        onDataDenied( data, interest, delay, "missing auth tag" );
+        onDataDenied( data.get(), interest, delay, "missing auth tag" );
         tracers::router->validation
         ( tracers::ValidationFailureNoAuth );
-        tracers::router->sent_data( data );
+        tracers::router->sent_data( data.get() );
         return true;
     }
     
@@ -85,28 +124,45 @@ RouterStrategy::filterOutgoingData
     
     // if data access level is greater than auth level
     // then reject
-    if( data.getAccessLevel() > auth.getAccessLevel() )
+    if( data.get().getAccessLevel() > auth.getAccessLevel() )
     {
         toNack( data, interest );
-        onDataDenied( data, interest, delay,
+        onDataDenied( data.get(), interest, delay,
                       "insufficient access level" );
         tracers::router->validation
         ( tracers::ValidationFailureLowAuth );
-        tracers::router->sent_data( data );
+        tracers::router->sent_data( data.get() );
         return true;
     }
     
     // if the auth and data aren't signed by the
     // same entity then reject the data
-    if( !data.getSignature().hasKeyLocator()
-      || auth.getKeyLocator() != data.getSignature().getKeyLocator() )
+    if( !data.get().getSignature().hasKeyLocator()
+      || auth.getKeyLocator() != data.get().getSignature().getKeyLocator() )
     {
         toNack( data, interest );
-        onDataDenied( data, interest, delay,
+        onDataDenied( data.get(), interest, delay,
                       "missmatched key locators" );
         tracers::router->validation
         ( tracers::ValidationFailureBadKeyLoc );
-        tracers::router->sent_data( data );
+        tracers::router->sent_data( data.get() );
+        return true;
+    }
+    
+    // if the tag has already been validated for this
+    // content then we don't need to verify it again;
+    // this mostly helps with content store hits.  The
+    // cheap checks above still run first, since the memo
+    // doesn't know which key signed the data
+    if( m_validation_memo.contains( auth, data.get() ) )
+    {
+        if( interest.getAuthValidityProb() > 0 )
+            data.modify().setNoReCacheFlag( true );
+        toSatisfy( data, interest );
+        onDataSatisfied( data.get(), interest, delay );
+        tracers::router->validation
+        ( tracers::ValidationSuccessMemo );
+        tracers::router->sent_data( data.get() );
         return true;
     }
     
@@ -116,7 +172,7 @@ RouterStrategy::filterOutgoingData
     // not to recache
     if( interest.getAuthValidityProb() > 0 )
     {
-        data.setNoReCacheFlag( true );
+        data.modify().setNoReCacheFlag( true );
     }
 
     // with a probability equivalent to the interest's
@@ -125,89 +181,211 @@ RouterStrategy::filterOutgoingData
     if( (uint32_t)rand() < interest.getAuthValidityProb() )
     {
         toSatisfy( data, interest );
-        onDataSatisfied( data, interest, delay );
+        onDataSatisfied( data.get(), interest, delay );
         tracers::router->validation
         ( tracers::ValidationSuccessValProb );
-        tracers::router->sent_data( data );
+        tracers::router->sent_data( data.get() );
         return true;
     }
     
 
     // use the auth cache for optimization
     // this step likely isn't really that usefull
-    // we may remove it later
-    tracers::router->bloom_lookup( auth, s_router_bloom_delay );
-    delay += s_router_bloom_delay;
-    if( interest.getAuthValidityProb() > 0
-      && m_auth_cache.contains( auth ) )
+    // we may remove it later; the cache isn't consulted
+    // for interests that don't trust it, and in a batch the
+    // tag is only looked up for its first downstream
+    TagValidation* validation = findValidation( auth );
+    bool cached = false;
+    if( validation && validation->looked_up )
+    {
+        cached = validation->cached;
+    }
+    else
+    {
+        tracers::router->bloom_lookup( auth, m_config.bloom_delay );
+        tracers::spans->span( interest.getNonce(), tracers::SpanRouterBloom,
+                              m_config.bloom_delay );
+        delay += m_config.bloom_delay;
+        if( interest.getAuthValidityProb() > 0 )
+        {
+            cached = m_auth_cache.contains( auth );
+            if( validation )
+            {
+                validation->looked_up = true;
+                validation->cached = cached;
+            }
+        }
+    }
+    if( interest.getAuthValidityProb() > 0 && cached )
     {
         toSatisfy( data, interest );
-        onDataSatisfied( data, interest, delay );
+        onDataSatisfied( data.get(), interest, delay );
         tracers::router->validation
         ( tracers::ValidationSuccessBloom );
-        tracers::router->sent_data( data );
+        tracers::router->sent_data( data.get() );
         return true;
     }
     
     // we simulate signature verification computation
-    // overhead by setting the delay to an estimated
-    // signature verification delay, since the signature
-    // is a dummy; we just consider any signature with
-    // the first byte set to 0 to be a bad signature,
-    // and all others to be good
-    tracers::router->sigverif( auth, s_router_signature_delay );
-    delay += RouterStrategy::s_router_signature_delay;
-    if( auth.getSignature().getValue().value_size() > 0
-      && auth.getSignature().getValue().value()[0] != 0 )
+    // overhead by adding the verification delay; with dummy
+    // signatures that's an estimated delay and we just consider
+    // any signature with the first byte set to 0 to be a bad
+    // signature, with real signatures it's the time the actual
+    // verification took; the signing key's context is looked
+    // up first, and tags signed by untrusted keys are invalid;
+    // in a batch the signature is only verified once
+    bool verify = !validation || !validation->verified;
+    bool valid;
+    if( verify )
+    {
+        ns3::Time verif_start = delay;
+        valid = lookupKeyContext( auth, delay,
+                                  tracers::router->key_context );
+        if( valid )
+        {
+            ns3::Time sigverif_delay = m_config.sigverif_delay;
+            valid = SignatureVerifier::get().verify
+                    ( auth, m_config.signature_mode, sigverif_delay );
+            tracers::router->sigverif( auth, sigverif_delay );
+            delay += sigverif_delay;
+        }
+        tracers::spans->span( interest.getNonce(),
+                              tracers::SpanRouterSigVerif,
+                              delay - verif_start );
+        if( validation )
+        {
+            validation->verified = true;
+            validation->valid = valid;
+        }
+    }
+    else
+    {
+        valid = validation->valid;
+    }
+    if( valid )
     {
         toSatisfy( data, interest );
-        onDataSatisfied( data, interest, delay );
+        onDataSatisfied( data.get(), interest, delay );
         tracers::router->validation
         ( tracers::ValidationSuccessSig );
-        tracers::router->sent_data( data );
+        tracers::router->sent_data( data.get() );
         
-        
-        tracers::router->bloom_insert( auth, s_router_bloom_delay );
-        delay += s_router_bloom_delay;
-        m_auth_cache.insert( auth );
+        // the tag only needs to be cached once
+        if( verify )
+        {
+            tracers::router->bloom_insert( auth, m_config.bloom_delay );
+            delay += m_config.bloom_delay;
+            m_auth_cache.insert( auth );
+            m_validation_memo.insert( auth, data.get() );
+        }
         return true;
     }
     
     // if any checks fail then reject the interest
     toNack( data, interest );
-    onDataDenied( data, interest, delay, "bad signature" );
+    onDataDenied( data.get(), interest, delay, "bad signature" );
     tracers::router->validation
     ( tracers::ValidationFailureSig );
-    tracers::router->sent_data( data );
+    tracers::router->sent_data( data.get() );
     return true;
 }
 
+void
+RouterStrategy::filterOutgoingData
+( std::vector< DataDownstream >& downstreams )
+{
+    // the validations are only kept for this batch,
+    // tags may be revoked or expire between batches
+    m_batching = true;
+    m_validations.clear();
+    BestRouteStrategy::filterOutgoingData( downstreams );
+    m_validations.clear();
+    m_batching = false;
+}
+
+RouterStrategy::TagValidation*
+RouterStrategy::findValidation( const ndn::AuthTag& auth )
+{
+    if( !m_batching )
+        return nullptr;
+
+    // batches are small, so a linear search is fine
+    const uint64_t* fp = auth.getFingerprint();
+    for( TagValidation& validation : m_validations )
+    {
+        if( validation.fingerprint[0] == fp[0]
+          && validation.fingerprint[1] == fp[1] )
+            return &validation;
+    }
+    m_validations.push_back
+    ( TagValidation{ { fp[0], fp[1] }, false, false, false, false } );
+    return &m_validations.back();
+}
+
+bool
+RouterStrategy::lookupKeyContext
+( const ndn::AuthTag& auth,
+  ns3::Time& delay,
+  ns3::TracedCallback< const ndn::KeyLocator&, bool, ns3::Time >& trace )
+{
+    if( !auth.getSignature().hasKeyLocator() )
+        return false;
+
+    const ndn::KeyLocator& locator = auth.getKeyLocator();
+    const KeyContextCache::Context* context = m_key_contexts->find( locator );
+    if( context )
+    {
+        trace( locator, true, ns3::Seconds( 0 ) );
+        return context->trusted;
+    }
+
+    // the trust decision is cached along with the
+    // context, so untrusted keys are rejected quickly
+    ns3::Time load_delay = m_config.key_load_delay;
+    bool trusted = SignatureVerifier::get().loadKey
+                   ( locator, m_config.signature_mode, load_delay );
+    trace( locator, false, load_delay );
+    delay += load_delay;
+    m_key_contexts->insert( locator, KeyContextCache::Context{ trusted } );
+    return trusted;
+}
+
 bool
 RouterStrategy::filterOutgoingInterest
 ( const nfd::Face&,
   ndn::Interest& interest,
   ns3::Time& delay )
 {
+    // with real signatures we start verifying the tag now,
+    // so the result is likely ready when the data comes back
+    if( interest.hasAuthTag() )
+        SignatureVerifier::get().prefetch( interest.getAuthTag(),
+                                           m_config.signature_mode );
+
     tracers::router->sent_interest( interest );
     return true;
 }
 
 void
-RouterStrategy::toNack( ndn::Data& data, const ndn::Interest& interest )
+RouterStrategy::toNack( nfd::fw::OutgoingData& data,
+                        const ndn::Interest& interest )
 {
-    data.setContentType( ndn::tlv::ContentType_Nack );
-    data.wireEncode();
+    if( data.get().getContentType() != ndn::tlv::ContentType_Nack )
+        data.modify().setContentType( ndn::tlv::ContentType_Nack );
 }
 
 void
-RouterStrategy::toSatisfy( ndn::Data& data, const ndn::Interest& interest )
+RouterStrategy::toSatisfy( nfd::fw::OutgoingData& data,
+                           const ndn::Interest& interest )
 {
-    data.setContentType( ndn::tlv::ContentType_Blob );
-    data.wireEncode();
+    // data that's already a blob is left shared
+    if( data.get().getContentType() != ndn::tlv::ContentType_Blob )
+        data.modify().setContentType( ndn::tlv::ContentType_Blob );
 }
 
 void
-RouterStrategy::toPreserve( ndn::Data& data, const ndn::Interest& interest )
+RouterStrategy::toPreserve( nfd::fw::OutgoingData& data,
+                            const ndn::Interest& interest )
 {
     // NADA
 }
@@ -248,4 +426,179 @@ RouterStrategy::onInterestDropped( const ndn::Interest& interest,
     // NADA
 }
 
+RouterStrategy::Config::Config( const std::string& file, uint32_t id )
+{
+    // set default values
+    auth_cache = Cache{ 1e-10, 10000, 4, AuthCache::StandardBloomBackend };
+    positive_cache = auth_cache;
+    negative_cache = auth_cache;
+    sigverif_delay = ns3::NanoSeconds( 30345 );
+    bloom_delay    = ns3::NanoSeconds( 2535 );
+    key_load_delay = ns3::Seconds( 0 );
+    key_context_cache_size = 1000;
+    validation_memo_size = 10000;
+    signature_mode = SignatureVerifier::DummySignatures;
+    sigverif_threads = 0;
+
+    // database and vm structs
+    unqlite* db;
+    unqlite_vm* vm;
+
+    // initialize database
+    int rc = unqlite_open( &db, ":mem:", UNQLITE_OPEN_READONLY );
+    if( rc != UNQLITE_OK )
+    {
+        // something went wrong
+        const char* err;
+        int errlen;
+        unqlite_config( db, UNQLITE_CONFIG_JX9_ERR_LOG,
+                        &err, &errlen );
+        std::cout << "Error: creating unqlite database: "
+                  << err << std::endl;
+        exit(1);
+    }
+
+    // initialize unqlite vm
+    rc = unqlite_compile_file( db, file.c_str(), &vm );
+    if( rc != UNQLITE_OK )
+    {
+        // something went wrong
+        const char* err;
+        int errlen;
+        unqlite_config( db, UNQLITE_CONFIG_JX9_ERR_LOG,
+                        &err, &errlen );
+        std::cout << "Error: compiling config script: "
+                  << err << std::endl;
+        exit(1);
+    }
+
+    unqlite_value* id_val = unqlite_vm_new_scalar( vm );
+    unqlite_value_int64( id_val, id );
+    rc = unqlite_vm_config( vm, UNQLITE_VM_CONFIG_CREATE_VAR,
+                            "ID", id_val );
+    if( rc != UNQLITE_OK )
+    {
+        // something went wrong
+        const char* err;
+        int errlen;
+        unqlite_config( db, UNQLITE_CONFIG_JX9_ERR_LOG,
+                        &err, &errlen );
+        std::cout << "Error: exporting ID to config: "
+                  << err << std::endl;
+        exit(1);
+    }
+    unqlite_vm_release_value( vm, id_val );
+
+    // execute config script
+    rc = unqlite_vm_exec( vm );
+    if( rc != UNQLITE_OK )
+    {
+        // something went wrong
+        const char* err;
+        int errlen;
+        unqlite_config( db, UNQLITE_CONFIG_JX9_ERR_LOG,
+                        &err, &errlen );
+        std::cout << "Error: executing config script: "
+                  << err << std::endl;
+        exit(1);
+    }
+
+    // read an auth cache's parameters from a json object of the
+    // form { fpp : 1e-10, size : 10000, generations : 4,
+    // backend : "standard" }, missing fields keep their defaults
+    auto load_cache = []( unqlite_value* obj, Cache& cache )
+    {
+        if( !obj || !unqlite_value_is_json_object( obj ) )
+            return;
+
+        unqlite_value* val;
+
+        val = unqlite_array_fetch( obj, "fpp", -1 );
+        if( val && unqlite_value_is_float( val ) )
+            cache.fpp = unqlite_value_to_double( val );
+
+        val = unqlite_array_fetch( obj, "size", -1 );
+        if( val && unqlite_value_is_int( val ) )
+            cache.size = unqlite_value_to_int64( val );
+
+        val = unqlite_array_fetch( obj, "generations", -1 );
+        if( val && unqlite_value_is_int( val ) )
+            cache.generations = unqlite_value_to_int64( val );
+
+        val = unqlite_array_fetch( obj, "backend", -1 );
+        if( val && unqlite_value_is_string( val ) )
+        {
+            int len;
+            const char* str = unqlite_value_to_string( val, &len );
+            std::string backend( str, len );
+            if( backend == "standard" )
+                cache.backend = AuthCache::StandardBloomBackend;
+            else if( backend == "blocked" )
+                cache.backend = AuthCache::BlockedBloomBackend;
+            else if( backend == "counting" )
+                cache.backend = AuthCache::CountingBloomBackend;
+            else if( backend == "exact" )
+                cache.backend = AuthCache::ExactBackend;
+            else
+                std::cout << "Warning: unknown auth cache backend '"
+                          << backend << "', using default" << std::endl;
+        }
+    };
+
+    // retrieve config values
+    unqlite_value* val;
+
+    val = unqlite_vm_extract_variable( vm, "sigverif_delay" );
+    if( val && unqlite_value_is_float( val ) )
+        sigverif_delay = ns3::Seconds( unqlite_value_to_double( val ) );
+    if( val && unqlite_value_is_int( val ) )
+        sigverif_delay = ns3::Seconds( unqlite_value_to_int64( val ) );
+
+    val = unqlite_vm_extract_variable( vm, "key_load_delay" );
+    if( val && unqlite_value_is_float( val ) )
+        key_load_delay = ns3::Seconds( unqlite_value_to_double( val ) );
+    if( val && unqlite_value_is_int( val ) )
+        key_load_delay = ns3::Seconds( unqlite_value_to_int64( val ) );
+
+    val = unqlite_vm_extract_variable( vm, "key_context_cache_size" );
+    if( val && unqlite_value_is_int( val ) )
+        key_context_cache_size = unqlite_value_to_int64( val );
+
+    val = unqlite_vm_extract_variable( vm, "bloom_delay" );
+    if( val && unqlite_value_is_float( val ) )
+        bloom_delay = ns3::Seconds( unqlite_value_to_double( val ) );
+    if( val && unqlite_value_is_int( val ) )
+        bloom_delay = ns3::Seconds( unqlite_value_to_int64( val ) );
+
+    val = unqlite_vm_extract_variable( vm, "validation_memo_size" );
+    if( val && unqlite_value_is_int( val ) )
+        validation_memo_size = unqlite_value_to_int64( val );
+
+    val = unqlite_vm_extract_variable( vm, "signature_mode" );
+    if( val && unqlite_value_is_string( val ) )
+    {
+        int len;
+        const char* str = unqlite_value_to_string( val, &len );
+        signature_mode = SignatureVerifier::parseMode
+                         ( std::string( str, len ) );
+    }
+
+    val = unqlite_vm_extract_variable( vm, "sigverif_threads" );
+    if( val && unqlite_value_is_int( val ) )
+        sigverif_threads = unqlite_value_to_int64( val );
+
+    load_cache( unqlite_vm_extract_variable( vm, "auth_cache" ),
+                auth_cache );
+    load_cache( unqlite_vm_extract_variable( vm, "positive_cache" ),
+                positive_cache );
+    load_cache( unqlite_vm_extract_variable( vm, "negative_cache" ),
+                negative_cache );
+
+    // release the vm
+    unqlite_vm_release( vm );
+
+    // close the db
+    unqlite_close( db );
+}
+
 }
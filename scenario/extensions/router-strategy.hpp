@@ -16,6 +16,9 @@
 #include "ns3/ndnSIM/NFD/daemon/fw/best-route-strategy.hpp"
 #include "ns3/ndnSIM/NFD/daemon/face/face.hpp"
 #include "auth-cache.hpp"
+#include "validation-memo.hpp"
+#include "signature-verifier.hpp"
+#include "key-context-cache.hpp"
 
 
 #ifndef ROUTER_STRATEGY__INCLUDED
@@ -30,11 +33,24 @@ namespace ndntac
       RouterStrategy( nfd::Forwarder& forwarder,
                       const ndn::Name& name = STRATEGY_NAME );
 
+    protected:
+      // used by derived strategies to load their own config file
+      RouterStrategy( nfd::Forwarder& forwarder,
+                      const ndn::Name& name,
+                      const std::string& config );
+
+    public:
+
       bool
       filterOutgoingData( const nfd::Face& face,
                           const ndn::Interest& interest,
-                          ndn::Data& data,
+                          nfd::fw::OutgoingData& data,
                           ns3::Time& delay ) override;
+
+      // validates each distinct AuthTag only once for all
+      // downstreams that requested the data with it
+      void
+      filterOutgoingData( std::vector< DataDownstream >& downstreams ) override;
       
       bool
       filterOutgoingInterest( const nfd::Face&,
@@ -62,29 +78,99 @@ namespace ndntac
                          const std::string& why );
       
       virtual void
-      toNack( ndn::Data& data, const ndn::Interest& interest );
+      toNack( nfd::fw::OutgoingData& data, const ndn::Interest& interest );
       
       virtual void
-      toSatisfy( ndn::Data& data, const ndn::Interest& interest );
+      toSatisfy( nfd::fw::OutgoingData& data, const ndn::Interest& interest );
       
       virtual void
-      toPreserve( ndn::Data& data, const ndn::Interest& interest );
+      toPreserve( nfd::fw::OutgoingData& data, const ndn::Interest& interest );
+
+      // result of validating an AuthTag, shared by the
+      // downstreams of a batch that use the same tag
+      struct TagValidation
+      {
+        uint64_t fingerprint[2];
+        bool     looked_up;
+        bool     cached;
+        bool     verified;
+        bool     valid;
+      };
+
+      // find the tag's validation in the current batch, nullptr
+      // if no batch is being filtered
+      TagValidation*
+      findValidation( const ndn::AuthTag& auth );
+
+      // look up the context of the key that signed the tag,
+      // adding the load delay on a miss; returns false if the
+      // key isn't trusted, in which case the tag is invalid
+      bool
+      lookupKeyContext
+      ( const ndn::AuthTag& auth,
+        ns3::Time& delay,
+        ns3::TracedCallback< const ndn::KeyLocator&,
+                             bool, ns3::Time >& trace );
 
     public:
        static std::string s_config;
        static const ndn::Name STRATEGY_NAME;
     protected:
+            uint32_t m_instance_id;
+            static uint32_t s_instance_id;
+
+            struct Config
+            {
+                // load config from file
+                Config( const std::string& file, uint32_t id );
+
+                // auth cache parameters
+                struct Cache
+                { double fpp;
+                  uint32_t size;
+                  uint32_t generations;
+                  AuthCache::Backend backend; };
+
+                // cache used for validation by all routers
+                Cache auth_cache;
+
+                // edge router caches
+                Cache positive_cache;
+                Cache negative_cache;
+
+                // delay for each signature verification, only
+                // used with dummy signatures
+                ns3::Time sigverif_delay;
+
+                // delay for loading a key's context on a key
+                // context cache miss, only used with dummy signatures
+                ns3::Time key_load_delay;
+
+                // max number of key contexts cached by the node
+                uint32_t key_context_cache_size;
+
+                // dummy or real signature verification, and the
+                // min number of threads to verify real signatures on
+                SignatureVerifier::Mode signature_mode;
+                uint32_t sigverif_threads;
+
+                // delay for each bloom lookup or insert
+                ns3::Time bloom_delay;
+
+                // max number of validated ( tag, content ) pairs
+                // to remember, 0 to disable
+                uint32_t validation_memo_size;
+            };
+            Config m_config;
+
             TxQueue m_queue;
             AuthCache m_auth_cache;
+            ValidationMemo m_validation_memo;
+            std::shared_ptr< KeyContextCache > m_key_contexts;
             nfd::Forwarder& m_forwarder;
 
-    protected:
-            uint32_t m_instance_id;
-            static uint32_t s_instance_id;
-    private:
-            static const ns3::Time s_router_signature_delay;
-            static const ns3::Time s_router_bloom_delay;
-            static const ns3::Time s_router_interest_delay;
+            bool m_batching = false;
+            std::vector< TagValidation > m_validations;
     };
 
 };
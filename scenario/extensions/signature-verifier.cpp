@@ -0,0 +1,418 @@
+#include "signature-verifier.hpp"
+#include "ndn-cxx/security/cryptopp.hpp"
+#include "ndn-cxx/encoding/buffer.hpp"
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+
+namespace ndntac
+{
+
+const size_t
+SignatureVerifier::s_max_results = 100000;
+const size_t
+SignatureVerifier::s_max_batch = 64;
+
+struct SignatureVerifier::SigningKey
+{
+    Mode mode;
+    CryptoPP::RSA::PrivateKey rsa;
+    CryptoPP::ECDSA< CryptoPP::ECP, CryptoPP::SHA256 >::PrivateKey ecdsa;
+};
+
+struct SignatureVerifier::KeyContext
+{
+    Mode mode;
+
+    // the published public key, CryptoPP verifiers can't be used
+    // by several threads at once so each worker loads its own
+    std::string der;
+
+    // wall clock time it took to load the context
+    int64_t load_nanoseconds;
+};
+
+namespace
+{
+
+typedef CryptoPP::RSASS< CryptoPP::PKCS1v15,
+                         CryptoPP::SHA256 >::Verifier RsaVerifier;
+typedef CryptoPP::ECDSA< CryptoPP::ECP,
+                         CryptoPP::SHA256 >::Verifier EcdsaVerifier;
+
+// copies the signed portion of a tag's encoding
+std::string
+signedPortion( const ndn::AuthTag& tag )
+{
+    ndn::Block wire = tag.wireEncode();
+    wire.parse();
+    const ndn::Block& portion = wire.get( ndn::tlv::SignedPortion );
+    return std::string( (const char*)portion.value(), portion.value_size() );
+}
+
+// parses a DER encoded public key, and builds its verifier;
+// keys that support it ( ECDSA ) get precomputed tables
+template< typename VERIFIER >
+std::unique_ptr< VERIFIER >
+loadVerifier( const std::string& der )
+{
+    CryptoPP::ByteQueue queue;
+    queue.Put( (const uint8_t*)der.data(), der.size() );
+    typename VERIFIER::KeyClass public_key;
+    public_key.Load( queue );
+    std::unique_ptr< VERIFIER > verifier( new VERIFIER( public_key ) );
+    if( verifier->AccessKey().SupportsPrecomputation() )
+        verifier->AccessKey().Precompute( 16 );
+    return verifier;
+}
+
+}
+
+SignatureVerifier::Mode
+SignatureVerifier::parseMode( const std::string& name )
+{
+    if( name == "dummy" )
+        return DummySignatures;
+    if( name == "rsa" )
+        return RsaSignatures;
+    if( name == "ecdsa" )
+        return EcdsaSignatures;
+
+    std::cout << "Warning: unknown signature mode '"
+              << name << "', using dummy signatures" << std::endl;
+    return DummySignatures;
+}
+
+SignatureVerifier&
+SignatureVerifier::get()
+{
+    static SignatureVerifier verifier;
+    return verifier;
+}
+
+SignatureVerifier::SignatureVerifier()
+{ }
+
+SignatureVerifier::~SignatureVerifier()
+{
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_stop = true;
+    }
+    m_cond.notify_all();
+    for( std::thread& thread : m_threads )
+        thread.join();
+}
+
+void
+SignatureVerifier::reserveThreads( size_t n )
+{
+    if( n == 0 )
+        n = std::max( std::thread::hardware_concurrency(), 1u );
+    while( m_threads.size() < n )
+        m_threads.emplace_back( &SignatureVerifier::work, this );
+}
+
+void
+SignatureVerifier::sign( ndn::AuthTag& tag, Mode mode, uint32_t key_size )
+{
+    using namespace CryptoPP;
+
+    if( mode == DummySignatures )
+        return;
+
+    // keys are only ever generated and used from the simulation
+    // thread, so one generator is enough
+    static AutoSeededRandomPool rng;
+
+    const ndn::Name& key_name = tag.getKeyLocator().getName();
+    std::shared_ptr< SigningKey >& key = m_signing_keys[ key_name ];
+    if( !key )
+    {
+        key = std::make_shared< SigningKey >();
+        key->mode = mode;
+
+        // the public key is published in its encoded form, and
+        // loaded from that like a fetched certificate would be
+        std::string der;
+        StringSink sink( der );
+        if( mode == RsaSignatures )
+        {
+            key->rsa.GenerateRandomWithKeySize( rng, key_size );
+            RSA::PublicKey( key->rsa ).Save( sink );
+        }
+        else
+        {
+            key->ecdsa.Initialize( rng, key_size == 384
+                                        ? ASN1::secp384r1()
+                                        : ASN1::secp256r1() );
+            ECDSA< ECP, SHA256 >::PublicKey ecdsa_public;
+            key->ecdsa.MakePublicKey( ecdsa_public );
+            ecdsa_public.Save( sink );
+        }
+
+        // the key is loaded once here to measure what loading
+        // it costs, the workers load their own copies to use
+        auto start = std::chrono::steady_clock::now();
+        if( mode == RsaSignatures )
+            loadVerifier< RsaVerifier >( der );
+        else
+            loadVerifier< EcdsaVerifier >( der );
+        auto end = std::chrono::steady_clock::now();
+
+        auto context = std::make_shared< KeyContext >();
+        context->mode = mode;
+        context->der = der;
+        context->load_nanoseconds
+            = std::chrono::duration_cast< std::chrono::nanoseconds >
+              ( end - start ).count();
+        m_public_keys[ key_name ] = context;
+    }
+
+    // the signature type is part of the signed portion,
+    // so it's set before signing
+    ndn::SignatureInfo info( tag.getSignature().getSignatureInfo() );
+    info.setSignatureType( key->mode == RsaSignatures
+                           ? ndn::tlv::SignatureSha256WithRsa
+                           : ndn::tlv::SignatureSha256WithEcdsa );
+    tag.setSignature( ndn::Signature( info ) );
+
+    std::string portion = signedPortion( tag );
+    std::string value;
+    if( key->mode == RsaSignatures )
+    {
+        RSASS< PKCS1v15, SHA256 >::Signer signer( key->rsa );
+        StringSource( portion, true,
+                      new SignerFilter( rng, signer,
+                                        new StringSink( value ) ) );
+    }
+    else
+    {
+        ECDSA< ECP, SHA256 >::Signer signer( key->ecdsa );
+        StringSource( portion, true,
+                      new SignerFilter( rng, signer,
+                                        new StringSink( value ) ) );
+    }
+
+    tag.setSignatureValue
+    ( ndn::Block( ndn::tlv::SignatureValue,
+                  std::make_shared< ndn::Buffer >( value.data(),
+                                                   value.size() ) ) );
+}
+
+void
+SignatureVerifier::prefetch( const ndn::AuthTag& tag, Mode mode )
+{
+    if( mode != DummySignatures )
+        submit( tag );
+}
+
+bool
+SignatureVerifier::verify( const ndn::AuthTag& tag,
+                           Mode mode,
+                           ns3::Time& delay )
+{
+    if( mode == DummySignatures )
+    {
+        return tag.getSignature().getValue().value_size() > 0
+            && tag.getSignature().getValue().value()[0] != 0;
+    }
+
+    Result result = submit( tag ).get();
+    delay = ns3::NanoSeconds( result.nanoseconds );
+    return result.valid;
+}
+
+bool
+SignatureVerifier::loadKey( const ndn::KeyLocator& locator,
+                            Mode mode,
+                            ns3::Time& delay )
+{
+    if( mode == DummySignatures )
+        return true;
+
+    // unknown keys are rejected without any real cost
+    delay = ns3::Seconds( 0 );
+    if( locator.getType() != ndn::KeyLocator::KeyLocator_Name )
+        return false;
+    auto it = m_public_keys.find( locator.getName() );
+    if( it == m_public_keys.end() )
+        return false;
+
+    delay = ns3::NanoSeconds( it->second->load_nanoseconds );
+    return true;
+}
+
+std::shared_future< SignatureVerifier::Result >
+SignatureVerifier::submit( const ndn::AuthTag& tag )
+{
+    const uint64_t* fp = tag.getFingerprint();
+    Fingerprint fingerprint{ { fp[0], fp[1] } };
+    auto it = m_results.find( fingerprint );
+    if( it != m_results.end() )
+        return it->second;
+
+    if( m_threads.empty() )
+        reserveThreads( 0 );
+
+    // tags without a published key can't be valid
+    std::shared_ptr< const KeyContext > key;
+    if( tag.getSignature().hasKeyLocator()
+      && tag.getKeyLocator().getType() == ndn::KeyLocator::KeyLocator_Name )
+    {
+        auto key_it = m_public_keys.find( tag.getKeyLocator().getName() );
+        if( key_it != m_public_keys.end() )
+            key = key_it->second;
+    }
+
+    std::shared_future< Result > result;
+    if( !key )
+    {
+        std::promise< Result > invalid;
+        invalid.set_value( Result{ false, 0 } );
+        result = invalid.get_future().share();
+    }
+    else
+    {
+        // the job gets its own copies of everything it needs,
+        // the tag may be gone by the time it runs
+        const ndn::Block& sig_value = tag.getSignature().getValue();
+        Job job{ key,
+                 tag.getSignature().getType(),
+                 signedPortion( tag ),
+                 std::string( (const char*)sig_value.value(),
+                              sig_value.value_size() ),
+                 std::make_shared< std::promise< Result > >() };
+        result = job.result->get_future().share();
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            m_jobs.push_back( std::move( job ) );
+        }
+        m_cond.notify_one();
+    }
+
+    m_results.emplace( fingerprint, result );
+    m_result_order.push_back( fingerprint );
+    if( m_result_order.size() > s_max_results )
+    {
+        m_results.erase( m_result_order.front() );
+        m_result_order.pop_front();
+    }
+    return result;
+}
+
+void
+SignatureVerifier::work()
+{
+    std::vector< Job > batch;
+    while( true )
+    {
+        {
+            std::unique_lock< std::mutex > lock( m_mutex );
+            m_cond.wait( lock, [this]()
+                               { return m_stop || !m_jobs.empty(); } );
+            if( m_stop )
+                return;
+
+            // take the first job, along with the other queued
+            // jobs for the same key
+            batch.clear();
+            batch.push_back( std::move( m_jobs.front() ) );
+            m_jobs.pop_front();
+            for( auto it = m_jobs.begin() ;
+                 it != m_jobs.end() && batch.size() < s_max_batch ; )
+            {
+                if( it->key == batch.front().key )
+                {
+                    batch.push_back( std::move( *it ) );
+                    it = m_jobs.erase( it );
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        verifyBatch( batch );
+    }
+}
+
+void
+SignatureVerifier::verifyBatch( std::vector< Job >& batch )
+{
+    // each worker keeps its own verifiers, loaded the first time
+    // it uses a key; entries hold on to their key so its address
+    // can't be reused by another key while they exist
+    struct WorkerKey
+    {
+        std::shared_ptr< const KeyContext > key;
+        std::unique_ptr< RsaVerifier >      rsa;
+        std::unique_ptr< EcdsaVerifier >    ecdsa;
+    };
+    static thread_local std::unordered_map< const KeyContext*,
+                                            WorkerKey > worker_keys;
+
+    const std::shared_ptr< const KeyContext >& context
+        = batch.front().key;
+    std::vector< bool > valid( batch.size(), false );
+    int64_t nanoseconds = 0;
+    try
+    {
+        WorkerKey& key = worker_keys[ context.get() ];
+        if( !key.key )
+        {
+            if( context->mode == RsaSignatures )
+                key.rsa = loadVerifier< RsaVerifier >( context->der );
+            else
+                key.ecdsa = loadVerifier< EcdsaVerifier >( context->der );
+            key.key = context;
+        }
+
+        // only the verifications themselves are timed, loading
+        // the key is charged separately by the nodes ( see loadKey )
+        auto start = std::chrono::steady_clock::now();
+
+        // signatures are in CryptoPP's raw ( r, s ) format
+        // instead of the DER used by ndn-cxx for ECDSA, since
+        // we're the only ones signing and verifying them
+        for( size_t i = 0 ; i < batch.size() ; i++ )
+        {
+            const Job& job = batch[i];
+            if( key.rsa
+              && job.type == ndn::tlv::SignatureSha256WithRsa )
+            {
+                valid[i] = key.rsa->VerifyMessage
+                           ( (const uint8_t*)job.portion.data(),
+                             job.portion.size(),
+                             (const uint8_t*)job.value.data(),
+                             job.value.size() );
+            }
+            else if( key.ecdsa
+                   && job.type == ndn::tlv::SignatureSha256WithEcdsa )
+            {
+                valid[i] = key.ecdsa->VerifyMessage
+                           ( (const uint8_t*)job.portion.data(),
+                             job.portion.size(),
+                             (const uint8_t*)job.value.data(),
+                             job.value.size() );
+            }
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        nanoseconds
+            = std::chrono::duration_cast< std::chrono::nanoseconds >
+              ( end - start ).count();
+    }
+    catch( CryptoPP::Exception& )
+    {
+        // a bad key fails the rest of the batch, signatures
+        // that were already checked keep their results
+    }
+
+    // each tag is charged an even share of the batch
+    nanoseconds /= (int64_t)batch.size();
+    for( size_t i = 0 ; i < batch.size() ; i++ )
+        batch[i].result->set_value( Result{ valid[i], nanoseconds } );
+}
+
+}
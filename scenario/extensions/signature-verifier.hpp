@@ -0,0 +1,226 @@
+/**
+* @class ndntac::SignatureVerifier
+* Real signing and verification of AuthTag signatures.
+*
+* By default the simulation uses dummy signatures; a signature is
+* considered valid unless its first byte is 0, and each verification
+* costs a fixed configured delay.  With real signatures enabled the
+* producers sign their tags with an RSA or ECDSA key, and the routers
+* verify them with CryptoPP.  The wall clock time each verification
+* took is then charged as its simulated delay, so the cost follows
+* the key type and size.
+*
+* Verifications run on a pool of worker threads.  Routers start
+* verifying a tag when they forward its interest ( see prefetch ),
+* so by the time its data comes back the result is usually ready,
+* and the verifications of many tags overlap in wall clock time.
+* Results are shared by all nodes, but every node that uses one is
+* still charged the measured delay.
+*
+* A worker takes all queued tags signed with the same key as one
+* batch.  Its verifier for the key, with the key's precomputed tables,
+* is looked up once for the batch and the tags are verified back to
+* back, and the time the whole batch took is split evenly between its
+* tags.  CryptoPP has no batch verification, so the signatures are
+* still checked one by one.
+*
+* Keys are generated when a producer first signs with a key locator,
+* and their public parts are published to the verifier, which stands
+* in for fetching the producer's certificate.  The verifier measures
+* what loading each published key costs, parsing it and building its
+* verification tables, and nodes are charged that for loading a key by
+* their own KeyContextCache ( see loadKey ).  Since CryptoPP verifiers
+* can't be shared between threads, each worker loads its own copy of
+* a key the first time it verifies with it.
+*
+* @author Ray Stubbs [stubbs.ray@gmail.com]
+**/
+
+#ifndef SIGNATURE_VERIFIER_INCLUDED
+#define SIGNATURE_VERIFIER_INCLUDED
+
+#include "ns3/core-module.h"
+#include "ndn-cxx/name.hpp"
+#include "ndn-cxx/auth-tag.hpp"
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ndntac
+{
+
+  class SignatureVerifier
+  {
+  public:
+    enum Mode
+    {
+      DummySignatures,
+      RsaSignatures,
+      EcdsaSignatures
+    };
+
+    /**
+    * @brief Parse a mode from its config name
+    * @param name  One of "dummy", "rsa" or "ecdsa"
+    * @return The mode, DummySignatures if the name is unknown
+    **/
+    static Mode
+    parseMode( const std::string& name );
+
+    /**
+    * @brief Get the verifier shared by all nodes
+    **/
+    static SignatureVerifier&
+    get();
+
+    ~SignatureVerifier();
+
+    /**
+    * @brief Make sure the worker pool has at least n threads,
+    *        0 for one per hardware thread
+    **/
+    void
+    reserveThreads( size_t n );
+
+    /**
+    * @brief Sign a tag with the key of its key locator
+    *
+    * The key is generated on first use, later calls with the same
+    * locator reuse it regardless of mode and key size.  Tags are
+    * left unchanged in DummySignatures mode.
+    *
+    * @param tag       Tag to sign, must have a name key locator
+    * @param mode      Type of key to sign with
+    * @param key_size  Modulus size for RSA, curve size for ECDSA
+    **/
+    void
+    sign( ndn::AuthTag& tag, Mode mode, uint32_t key_size );
+
+    /**
+    * @brief Start verifying a tag's signature in the background,
+    *        does nothing in DummySignatures mode
+    **/
+    void
+    prefetch( const ndn::AuthTag& tag, Mode mode );
+
+    /**
+    * @brief Verify a tag's signature
+    *
+    * In DummySignatures mode the signature is valid unless its
+    * first byte is 0, and the delay is left as is.  Otherwise this
+    * waits for the verification, starting it if it wasn't prefetched,
+    * and sets the delay to the time it took.
+    *
+    * @param tag    Tag to verify
+    * @param mode   Signature mode of the verifying node
+    * @param delay  Set to the verification delay
+    * @return true if the signature is valid
+    **/
+    bool
+    verify( const ndn::AuthTag& tag, Mode mode, ns3::Time& delay );
+
+    /**
+    * @brief Load the context of a key
+    *
+    * In DummySignatures mode every key is trusted and the delay is
+    * left as is.  Otherwise a key is trusted if a producer published
+    * it, and the delay is set to the time loading it took.
+    *
+    * @param locator  Locator of the key
+    * @param mode     Signature mode of the loading node
+    * @param delay    Set to the load delay
+    * @return true if the key is trusted
+    **/
+    bool
+    loadKey( const ndn::KeyLocator& locator, Mode mode, ns3::Time& delay );
+
+  public:
+    struct Result
+    {
+      bool    valid;
+      int64_t nanoseconds;
+    };
+
+  private:
+    SignatureVerifier();
+
+    // defined in the .cpp, so CryptoPP stays out of the header
+    struct SigningKey;
+    struct KeyContext;
+
+    struct Fingerprint
+    {
+      uint64_t words[2];
+
+      bool operator==( const Fingerprint& other ) const
+      {
+        return words[0] == other.words[0]
+            && words[1] == other.words[1];
+      }
+    };
+
+    struct FingerprintHash
+    {
+      size_t operator()( const Fingerprint& fp ) const
+      {
+        // the fingerprint is already a good hash
+        return fp.words[0];
+      }
+    };
+
+    // a queued verification
+    struct Job
+    {
+      std::shared_ptr< const KeyContext >       key;
+      uint32_t                                  type;
+      std::string                               portion;
+      std::string                               value;
+      std::shared_ptr< std::promise< Result > > result;
+    };
+
+    std::shared_future< Result >
+    submit( const ndn::AuthTag& tag );
+
+    void
+    work();
+
+    // runs on the worker threads, so it only touches the jobs;
+    // all jobs of a batch are for the same key
+    static void
+    verifyBatch( std::vector< Job >& batch );
+
+    // max number of verification results to keep
+    static const size_t s_max_results;
+
+    // max number of tags verified in one batch
+    static const size_t s_max_batch;
+
+    // keys, only used from the simulation thread; the workers
+    // only get const references to the published contexts
+    std::map< ndn::Name, std::shared_ptr< SigningKey > > m_signing_keys;
+    std::map< ndn::Name, std::shared_ptr< const KeyContext > > m_public_keys;
+
+    // results by tag fingerprint, oldest are dropped first
+    std::unordered_map< Fingerprint,
+                        std::shared_future< Result >,
+                        FingerprintHash > m_results;
+    std::deque< Fingerprint > m_result_order;
+
+    // worker pool
+    std::vector< std::thread >            m_threads;
+    std::deque< Job >                     m_jobs;
+    std::mutex                            m_mutex;
+    std::condition_variable               m_cond;
+    bool                                  m_stop = false;
+  };
+
+};
+
+#endif // SIGNATURE_VERIFIER_INCLUDED
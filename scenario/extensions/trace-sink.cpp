@@ -0,0 +1,100 @@
+#include "trace-sink.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace ndntac
+{
+namespace tracers
+{
+
+TraceSink::TraceSink( const std::string& file, size_t capacity )
+    : m_file( file, std::ios::out | std::ios::binary | std::ios::trunc ),
+      m_good( m_file.good() ),
+      m_buffer( std::max( capacity, (size_t)4 ) )
+{
+    if( !m_good )
+        std::cerr << "Error opening log file '" << file << "'" << std::endl;
+    else
+        m_writer = std::thread( &TraceSink::work, this );
+}
+
+TraceSink::~TraceSink()
+{
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_stop = true;
+    }
+    m_filled.notify_one();
+    if( m_writer.joinable() )
+        m_writer.join();
+    m_file.close();
+}
+
+void
+TraceSink::push( const TraceRecord& record )
+{
+    if( !m_good )
+        return;
+
+    size_t capacity = m_buffer.size();
+    std::unique_lock< std::mutex > lock( m_mutex );
+    m_drained.wait( lock, [this,capacity]()
+                          { return m_end - m_begin < capacity; } );
+    m_buffer[ m_end % capacity ] = record;
+    m_end++;
+
+    // the writer is only woken once a quarter of the
+    // buffer is waiting, so it writes in large chunks
+    if( m_end - m_begin == capacity/4 )
+    {
+        lock.unlock();
+        m_filled.notify_one();
+    }
+}
+
+bool
+TraceSink::read( std::istream& is, TraceRecord& record )
+{
+    is.read( (char*)&record, sizeof( record ) );
+    return is.gcount() == sizeof( record );
+}
+
+void
+TraceSink::work()
+{
+    size_t capacity = m_buffer.size();
+    while( true )
+    {
+        uint64_t begin, end;
+        {
+            std::unique_lock< std::mutex > lock( m_mutex );
+            m_filled.wait( lock, [this,capacity]()
+                                 { return m_stop
+                                       || m_end - m_begin >= capacity/4; } );
+            if( m_begin == m_end )
+                return;
+            begin = m_begin;
+            end   = m_end;
+        }
+
+        // the records being written can't be overwritten until
+        // m_begin moves past them, so this is done without the lock
+        while( begin < end )
+        {
+            size_t first = begin % capacity;
+            size_t count = std::min( end - begin, capacity - first );
+            m_file.write( (const char*)&m_buffer[ first ],
+                          count*sizeof( TraceRecord ) );
+            begin += count;
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( m_mutex );
+            m_begin = end;
+        }
+        m_drained.notify_one();
+    }
+}
+
+};
+};
@@ -0,0 +1,105 @@
+/**
+* @class ndntac::tracers::TraceSink
+* A buffered binary file for the interval traces.
+*
+* Instead of each trace formatting its rows as text into its own file,
+* all traces push fixed size records ( time, trace, column, value ) to
+* one sink.  Records are queued in a ring buffer and written to the
+* file in large chunks by a background thread, so the simulation
+* thread never formats or flushes anything.  The simulation only
+* blocks if the writer falls a whole buffer behind.
+*
+* The records can be converted back into the usual text traces
+* afterwards, see tracers::ConvertBinaryTraces.
+**/
+
+#ifndef TRACE_SINK_INCLUDED
+#define TRACE_SINK_INCLUDED
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ndntac
+{
+namespace tracers
+{
+
+  // how a record's value is printed in the text traces
+  enum TraceValueKind
+  {
+    ValueCount,
+    ValueDelay,     // nanoseconds, printed as an ns3::Time
+    ValueBytes      // printed with a 'bytes' suffix
+  };
+
+  struct TraceRecord
+  {
+    int64_t  time;      // nanoseconds of simulation time
+    int64_t  value;
+    uint16_t trace;
+    uint8_t  column;
+    uint8_t  kind;
+    uint32_t reserved;
+  };
+
+  class TraceSink
+  {
+  public:
+
+    /**
+    * @brief Constructor, opens the file and starts the writer
+    * @param file      Path of the binary file, truncated if it exists
+    * @param capacity  Number of records the ring buffer holds
+    **/
+    TraceSink( const std::string& file, size_t capacity = 1 << 16 );
+
+    /**
+    * @brief Writes all remaining records and closes the file
+    **/
+    ~TraceSink();
+
+    bool good() const
+    {
+      return m_good;
+    }
+
+    /**
+    * @brief Queue a record to be written
+    **/
+    void push( const TraceRecord& record );
+
+    /**
+    * @brief Read the next record of a binary trace
+    * @return false at the end of the trace
+    **/
+    static bool read( std::istream& is, TraceRecord& record );
+
+  private:
+    void work();
+
+    std::ofstream              m_file;
+    bool                       m_good;
+
+    // ring buffer, records in [ m_begin, m_end ) are waiting to be
+    // written; the indices only ever grow, and wrap when used
+    std::vector< TraceRecord > m_buffer;
+    uint64_t                   m_begin = 0;
+    uint64_t                   m_end   = 0;
+
+    std::thread                m_writer;
+    std::mutex                 m_mutex;
+    std::condition_variable    m_filled;
+    std::condition_variable    m_drained;
+    bool                       m_stop = false;
+  };
+
+};
+};
+
+#endif // TRACE_SINK_INCLUDED
@@ -1,9 +1,17 @@
 #include "tracers.hpp"
+#include "metrics.hpp"
+#include "latency-histogram.hpp"
+#include "trace-sink.hpp"
 #include "ns3/core-module.h"
 #include "ns3/network-module.h"
 #include "ns3/ndnSIM-module.h"
 #include "ns3/ndnSIM/utils/tracers/l2-rate-tracer.hpp"
 #include "ns3/ndnSIM/utils/tracers/ndn-l3-rate-tracer.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/tx-queue.hpp"
+#include <array>
+#include <deque>
+#include <map>
+#include <unordered_map>
 
 namespace ndntac
 {
@@ -141,6 +149,12 @@ RouterTrace::GetTypeId( void )
                          MakeTraceSourceAccessor
                          ( &RouterTrace::sigverif ),
                          "SigVerifTrace" )
+        .AddTraceSource( "KeyContextTrace",
+                         "Invoked when the router looks up the "
+                         "context of a signing key",
+                         MakeTraceSourceAccessor
+                         ( &RouterTrace::key_context ),
+                         "KeyContextTrace" )
         .AddTraceSource( "BloomLookupTrace",
                          "Called when the router performs"
                          " a bloom lookup",
@@ -187,12 +201,24 @@ EdgeTrace::GetTypeId( void )
                          MakeTraceSourceAccessor
                          ( &EdgeTrace::sigverif ),
                          "SigVerifTrace" )
+        .AddTraceSource( "KeyContextTrace",
+                         "Invoked when the edge looks up the "
+                         "context of a signing key",
+                         MakeTraceSourceAccessor
+                         ( &EdgeTrace::key_context ),
+                         "KeyContextTrace" )
         .AddTraceSource( "BloomLookupTrace",
                          "Called when the router performs"
                          " a bloom lookup",
                          MakeTraceSourceAccessor
                          ( &EdgeTrace::bloom_lookup ),
                          "BloomLookupTrace" )
+        .AddTraceSource( "CacheLookupTrace",
+                         "Called with the result of a bloom "
+                         "lookup in the positive or negative cache",
+                         MakeTraceSourceAccessor
+                         ( &EdgeTrace::cache_lookup ),
+                         "CacheLookupTrace" )
         .AddTraceSource( "BloomInsertTrace",
                          "Called when the router performs a "
                          "bloom insertion",
@@ -233,6 +259,29 @@ EdgeTrace::GetTypeId( void )
 };
 Ptr< EdgeTrace > edge;
 
+TypeId
+SpanTrace::GetTypeId( void )
+{
+  static ns3::TypeId tid
+      = ns3::TypeId("ndntac::SpanTrace")
+        .SetParent<Object>()
+        .AddConstructor<SpanTrace>()
+        .AddTraceSource( "SpanTrace",
+                         "Invoked when part of a request's "
+                         "latency is known",
+                         MakeTraceSourceAccessor
+                         ( &SpanTrace::span ),
+                         "SpanTrace" )
+        .AddTraceSource( "RequestTrace",
+                         "Invoked when a consumer's request "
+                         "is answered",
+                         MakeTraceSourceAccessor
+                         ( &SpanTrace::request ),
+                         "RequestTrace" );
+       return tid;
+};
+Ptr< SpanTrace > spans;
+
 // trace streams
 ofstream tags_created_trace_stream;
 ofstream tags_active_trace_stream;
@@ -245,6 +294,7 @@ ofstream validation_trace_stream;
 ofstream transmission_trace_stream;
 ofstream edgeblock_trace_stream;
 ofstream consumer_trace_stream;
+ofstream metrics_trace_stream;
 
 // intervals
 Time tags_created_trace_interval;
@@ -258,6 +308,7 @@ Time validation_trace_interval;
 Time transmission_trace_interval;
 Time edgeblock_trace_interval;
 Time consumer_trace_interval;
+Time metrics_trace_interval;
 
 // logger even ids
 EventId tags_created_event;
@@ -269,49 +320,182 @@ EventId validation_event;
 EventId transmission_event;
 EventId edgeblock_event;
 EventId consumer_event;
+EventId metrics_event;
 
 // trackers
-uint64_t tags_created = 0;
-uint64_t tags_active = 0;
-uint64_t interests_transmitted = 0;
-uint64_t datas_transmitted = 0;
-uint64_t tags_transmitted = 0;
-uint64_t interest_bytes_transmitted = 0;
-uint64_t data_bytes_transmitted = 0;
-uint64_t tag_bytes_transmitted = 0;
-uint64_t sigverifs = 0;
-Time     sigverifs_delay = Seconds( 0 );
-uint64_t bloom_lookups = 0;
-Time     bloom_lookups_delay = Seconds( 0 );
-uint64_t bloom_inserts = 0;
-Time     bloom_inserts_delay = Seconds( 0 );
-uint64_t validations_success_valprob = 0;
-uint64_t validations_success_bloom = 0;
-uint64_t validations_success_sig = 0;
-uint64_t validations_success_skipped = 0;
-uint64_t validations_failure_sig = 0;
-uint64_t validations_failure_noauth = 0;
-uint64_t validations_failure_lowauth = 0;
-uint64_t validations_failure_badkeyloc = 0;
-uint64_t validations_failure_expired = 0;
-uint64_t validations_failure_badprefix = 0;
-uint64_t validations_failure_badroute = 0;
-uint64_t authcached_positive_upstream = 0;
-uint64_t authcached_positive_moved = 0;
-uint64_t authcached_negative_upstream = 0;
-uint64_t edge_blocked_expired = 0;
-uint64_t edge_blocked_bad_prefix = 0;
-uint64_t edge_blocked_bad_route = 0;
-uint64_t consumer_denied = 0;
-uint64_t consumer_deserved = 0;
-uint64_t consumer_undeserved = 0;
-uint64_t consumer_unrequested = 0;
-uint64_t consumer_retx = 0;
-uint64_t consumer_timeout = 0;
-uint64_t consumer_received = 0;
-uint64_t consumer_requested = 0;
-Time     consumer_partial_delay = Seconds( 0 );
-Time     consumer_delay = Seconds( 0 );
+MetricsStore metrics;
+
+// latencies of the datas received by each consumer node since
+// the consumer trace was last logged, from the initial tx and
+// from the last retx
+struct ConsumerLatencies
+{
+    LatencyHistogram delay;
+    LatencyHistogram partial_delay;
+};
+map< uint32_t, ConsumerLatencies > consumer_latencies;
+
+// file names and headers of the text traces, the file
+// names are only used when converting binary traces
+struct TraceLayout
+{
+    const char* file;
+    const char* header;
+};
+const TraceLayout trace_layouts[TraceCount] =
+{
+    { "tags-created-trace.txt", "" },
+    { "tags-active-trace.txt", "" },
+    { "tag-sigverif-trace.txt", "" },
+    { "tag-bloom-trace.txt", "" },
+    { "overhead-trace.txt", "" },
+    { "validation-trace.txt", "" },
+    { "transmission-trace.txt", "" },
+    { "edgeblock-trace.txt", "" },
+    { "consumer-trace.txt",
+      "# 1. Time\n"
+      "# 2. Number of interests sent by all consumers\n"
+      "# 3. Number of datas received by all consumers\n"
+      "# 4. Number of nacks received by all consumers\n"
+      "# 5. Number of wrongful nacks\n"
+      "# 6. Number of wrongful datas\n"
+      "# 7. Number of unrequested datas\n"
+      "# 8. Number of retransmissions\n"
+      "# 9. Number of timeouts\n"
+      "# 10. Average delay between last retx and data receipt\n"
+      "# 11. Average delay between initial tx and data receipt\n"
+      "# 12-15. p50, p90, p99 and p99.9 of the delay between last\n"
+      "#        retx and data receipt, over the interval\n"
+      "# 16-19. p50, p90, p99 and p99.9 of the delay between initial\n"
+      "#        tx and data receipt, over the interval\n" }
+};
+
+// set if the interval traces are written as binary
+unique_ptr< TraceSink > binary_sink;
+
+// a record of the span trace, durations are in nanoseconds
+struct SpanRecord
+{
+    int64_t  time;      // when the request was answered
+    int64_t  latency;   // since the request was last sent
+    uint32_t nonce;
+    uint32_t reserved;
+    int64_t  spans[SpanCount];
+};
+
+// spans of the requests that haven't been answered yet,
+// only kept while the span trace is enabled; requests that
+// are never answered are dropped oldest first when there
+// are too many
+struct PendingSpans
+{
+    uint64_t                     order;
+    array< int64_t, SpanCount >  spans;
+};
+ofstream span_trace_stream;
+unordered_map< uint32_t, PendingSpans > pending_spans;
+
+// ( nonce, order ) of the pending requests in the order they
+// were first seen, includes requests answered since then
+deque< pair< uint32_t, uint64_t > > pending_order;
+uint64_t next_pending_order = 0;
+const size_t max_pending_spans = 1 << 20;
+
+// network wide totals of a metric
+int64_t
+total( Metric metric )
+{
+    return metrics.total( metric );
+}
+
+Time
+totalDelay( Metric metric )
+{
+    return NanoSeconds( metrics.total( metric ) );
+}
+
+// a value in a row of an interval trace
+struct Column
+{
+    TraceValueKind kind;
+    int64_t        value;
+};
+
+Column
+countColumn( int64_t value )
+{
+    return Column{ ValueCount, value };
+}
+
+Column
+delayColumn( Time value )
+{
+    return Column{ ValueDelay, value.GetNanoSeconds() };
+}
+
+Column
+bytesColumn( int64_t value )
+{
+    return Column{ ValueBytes, value };
+}
+
+void
+writeValue( ostream& os, TraceValueKind kind, int64_t value )
+{
+    switch( kind )
+    {
+        case ValueCount:
+            os << value;
+            break;
+        case ValueDelay:
+            os << NanoSeconds( value );
+            break;
+        case ValueBytes:
+            os << value << "bytes";
+            break;
+    }
+}
+
+// writes a row of the current time and the given values, either
+// to the trace's text stream or as records to the binary sink
+void
+writeRow( TraceId trace, ofstream& stream,
+          initializer_list< Column > columns )
+{
+    if( binary_sink )
+    {
+        int64_t now = Simulator::Now().GetNanoSeconds();
+        uint8_t column = 0;
+        for( const Column& c : columns )
+        {
+            binary_sink->push( TraceRecord{ now, c.value,
+                                            (uint16_t)trace, column++,
+                                            (uint8_t)c.kind, 0 } );
+        }
+        return;
+    }
+
+    stream << Simulator::Now();
+    for( const Column& c : columns )
+    {
+        stream << '\t';
+        writeValue( stream, c.kind, c.value );
+    }
+    stream << '\n';
+}
+
+// opens the text file of a trace, unless traces are binary
+void
+openTrace( ofstream& stream, const string& logfile, TraceId trace )
+{
+    if( binary_sink )
+        return;
+
+    stream.open( logfile );
+    if( !stream.good() )
+        cerr << "Error opening log file '" << logfile << "'" << endl;
+    stream << trace_layouts[trace].header;
+}
 
 
 // callbacks
@@ -319,31 +503,34 @@ void
 ProducerTagCreatedCallback
 ( const AuthTag& tag )
 {
-    tags_created++;
+    metrics.record( RoleProducer, MetricTagsCreated );
 }
 
 void
 ProducerSigVerifCallback
 ( const AuthTag& tag, Time delay )
 {
-    sigverifs++;
-    sigverifs_delay += delay;
+    metrics.record( RoleProducer, MetricSigverifs );
+    metrics.record( RoleProducer, MetricSigverifsDelay,
+                    delay.GetNanoSeconds() );
 }
 
 void
 ProducerBloomLookupCallback
 ( const AuthTag& tag, Time delay )
 {
-    bloom_lookups++;
-    bloom_lookups_delay += delay;
+    metrics.record( RoleProducer, MetricBloomLookups );
+    metrics.record( RoleProducer, MetricBloomLookupsDelay,
+                    delay.GetNanoSeconds() );
 }
 
 void
 ProducerBloomInsertCallback
 ( const AuthTag& tag, Time delay )
 {
-    bloom_inserts++;
-    bloom_inserts_delay += delay;
+    metrics.record( RoleProducer, MetricBloomInserts );
+    metrics.record( RoleProducer, MetricBloomInsertsDelay,
+                    delay.GetNanoSeconds() );
 }
 
 void
@@ -353,37 +540,40 @@ ProducerValidationCallback
     switch( detail )
     {
         case ValidationSuccessValProb:
-            validations_success_valprob++;
+            metrics.record( RoleProducer, MetricValidationsSuccessValProb );
             break;
         case ValidationSuccessBloom:
-            validations_success_bloom++;
+            metrics.record( RoleProducer, MetricValidationsSuccessBloom );
             break;
         case ValidationSuccessSig:
-            validations_success_sig++;
+            metrics.record( RoleProducer, MetricValidationsSuccessSig );
             break;
         case ValidationSuccessSkipped:
-            validations_success_skipped++;
+            metrics.record( RoleProducer, MetricValidationsSuccessSkipped );
+            break;
+        case ValidationSuccessMemo:
+            metrics.record( RoleProducer, MetricValidationsSuccessMemo );
             break;
         case ValidationFailureSig:
-            validations_failure_sig++;
+            metrics.record( RoleProducer, MetricValidationsFailureSig );
             break;
         case ValidationFailureNoAuth:
-            validations_failure_noauth++;
+            metrics.record( RoleProducer, MetricValidationsFailureNoAuth );
             break;
         case ValidationFailureLowAuth:
-            validations_failure_lowauth++;
+            metrics.record( RoleProducer, MetricValidationsFailureLowAuth );
             break;
         case ValidationFailureBadKeyLoc:
-            validations_failure_badkeyloc++;
+            metrics.record( RoleProducer, MetricValidationsFailureBadKeyLoc );
             break;
         case ValidationFailureExpired:
-            validations_failure_expired++;
+            metrics.record( RoleProducer, MetricValidationsFailureExpired );
             break;
         case ValidationFailureBadPrefix:
-            validations_failure_badprefix++;
+            metrics.record( RoleProducer, MetricValidationsFailureBadPrefix );
             break;
         case ValidationFailureBadRoute:
-            validations_failure_badroute++;
+            metrics.record( RoleProducer, MetricValidationsFailureBadRoute );
             break;
     }
 }
@@ -399,23 +589,25 @@ void
 ProducerSentDataCallback
 ( const Data& data )
 {
-    datas_transmitted++;
-    data_bytes_transmitted += data.wireEncode().size();
+    metrics.record( RoleProducer, MetricDatasTransmitted );
+    metrics.record( RoleProducer, MetricDataBytesTransmitted,
+                    data.wireSize() );
 }
 
 void
 ConsumerSentInterestCallback
 ( const Interest& interest )
 {
-    consumer_requested++;
-    interests_transmitted++;
-    interest_bytes_transmitted += interest.wireEncode().size();
+    metrics.record( RoleConsumer, MetricConsumerRequested );
+    metrics.record( RoleConsumer, MetricInterestsTransmitted );
+    metrics.record( RoleConsumer, MetricInterestBytesTransmitted,
+                    interest.wireSize() );
     
     if( interest.hasAuthTag() )
     {
-        tags_transmitted++;
-        tag_bytes_transmitted +=
-            interest.getAuthTag().wireEncode().size();
+        metrics.record( RoleConsumer, MetricTagsTransmitted );
+        metrics.record( RoleConsumer, MetricTagBytesTransmitted,
+                        interest.getAuthTag().wireSize() );
     }
 }
 
@@ -423,89 +615,111 @@ void
 ConsumerReceivedDataCallback
 ( const Data& data, Time sent, Time last_retx, Time received )
 {
-    consumer_received++;
-    consumer_partial_delay += ( received - last_retx );
-    consumer_delay += ( received - sent );
+    metrics.record( RoleConsumer, MetricConsumerReceived );
+    metrics.record( RoleConsumer, MetricConsumerPartialDelay,
+                    ( received - last_retx ).GetNanoSeconds() );
+    metrics.record( RoleConsumer, MetricConsumerDelay,
+                    ( received - sent ).GetNanoSeconds() );
+
+    ConsumerLatencies& latencies
+        = consumer_latencies[ Simulator::GetContext() ];
+    latencies.partial_delay.record( ( received - last_retx ).GetNanoSeconds() );
+    latencies.delay.record( ( received - sent ).GetNanoSeconds() );
 }
 
 void
 ConsumerDeniedCallback
 ( uint32_t seq )
 {
-    consumer_denied++;
+    metrics.record( RoleConsumer, MetricConsumerDenied );
 }
 
 void
 ConsumerDeservedCallback
 ( uint32_t seq )
 {
-    consumer_deserved++;
+    metrics.record( RoleConsumer, MetricConsumerDeserved );
 }
 
 void
 ConsumerUndeservedCallback
 ( uint32_t seq )
 {
-    consumer_undeserved++;
+    metrics.record( RoleConsumer, MetricConsumerUndeserved );
 }
 
 void
 ConsumerUnrequestedCallback
 ( void )
 {
-    consumer_unrequested++;
+    metrics.record( RoleConsumer, MetricConsumerUnrequested );
 }
 
 void
 ConsumerReceivedAuthCallback
 ( const AuthTag& tag )
 {
-    tags_active++;
+    metrics.record( RoleConsumer, MetricTagsActive );
 }
 
 void
 ConsumerDisposedAuthCallback
 ( const AuthTag& tag )
 {
-    tags_active--;
+    metrics.record( RoleConsumer, MetricTagsActive, -1 );
 }
 
 void
 ConsumerRetXCallback
 ( uint32_t seq )
 {
-    consumer_retx++;
+    metrics.record( RoleConsumer, MetricConsumerRetx );
 }
 
 void
 ConsumerTimeoutCallback
 ( uint32_t seq )
 {
-    consumer_timeout++;
+    metrics.record( RoleConsumer, MetricConsumerTimeout );
 }
 
 void
 RouterSigVerifCallback
 ( const AuthTag& tag, Time delay )
 {
-    sigverifs++;
-    sigverifs_delay += delay;
+    metrics.record( RoleRouter, MetricSigverifs );
+    metrics.record( RoleRouter, MetricSigverifsDelay,
+                    delay.GetNanoSeconds() );
+}
+
+void
+RouterKeyContextCallback
+( const KeyLocator& locator, bool hit, Time delay )
+{
+    if( hit )
+        metrics.record( RoleRouter, MetricKeyContextHits );
+    else
+        metrics.record( RoleRouter, MetricKeyContextMisses );
+    metrics.record( RoleRouter, MetricKeyContextDelay,
+                    delay.GetNanoSeconds() );
 }
 
 void
 RouterBloomLookupCallback
 ( const AuthTag& tag, Time delay )
 {
-    bloom_lookups++;
-    bloom_lookups_delay += delay;
+    metrics.record( RoleRouter, MetricBloomLookups );
+    metrics.record( RoleRouter, MetricBloomLookupsDelay,
+                    delay.GetNanoSeconds() );
 }
 
 void
 RouterBloomInsertCallback
 ( const AuthTag& tag, Time delay )
 {
-    bloom_inserts++;
-    bloom_inserts_delay += delay;
+    metrics.record( RoleRouter, MetricBloomInserts );
+    metrics.record( RoleRouter, MetricBloomInsertsDelay,
+                    delay.GetNanoSeconds() );
 }
 
 void
@@ -515,37 +729,40 @@ RouterValidationCallback
     switch( detail )
     {
         case ValidationSuccessValProb:
-            validations_success_valprob++;
+            metrics.record( RoleRouter, MetricValidationsSuccessValProb );
             break;
         case ValidationSuccessBloom:
-            validations_success_bloom++;
+            metrics.record( RoleRouter, MetricValidationsSuccessBloom );
             break;
         case ValidationSuccessSig:
-            validations_success_sig++;
+            metrics.record( RoleRouter, MetricValidationsSuccessSig );
             break;
         case ValidationSuccessSkipped:
-            validations_success_skipped++;
+            metrics.record( RoleRouter, MetricValidationsSuccessSkipped );
+            break;
+        case ValidationSuccessMemo:
+            metrics.record( RoleRouter, MetricValidationsSuccessMemo );
             break;
         case ValidationFailureSig:
-            validations_failure_sig++;
+            metrics.record( RoleRouter, MetricValidationsFailureSig );
             break;
         case ValidationFailureNoAuth:
-            validations_failure_noauth++;
+            metrics.record( RoleRouter, MetricValidationsFailureNoAuth );
             break;
         case ValidationFailureLowAuth:
-            validations_failure_lowauth++;
+            metrics.record( RoleRouter, MetricValidationsFailureLowAuth );
             break;
         case ValidationFailureBadKeyLoc:
-            validations_failure_badkeyloc++;
+            metrics.record( RoleRouter, MetricValidationsFailureBadKeyLoc );
             break;
         case ValidationFailureExpired:
-            validations_failure_expired++;
+            metrics.record( RoleRouter, MetricValidationsFailureExpired );
             break;
         case ValidationFailureBadPrefix:
-            validations_failure_badprefix++;
+            metrics.record( RoleRouter, MetricValidationsFailureBadPrefix );
             break;
         case ValidationFailureBadRoute:
-            validations_failure_badroute++;
+            metrics.record( RoleRouter, MetricValidationsFailureBadRoute );
             break;
     }
 }
@@ -554,14 +771,17 @@ void
 RouterSentInterestCallback
 ( const Interest& interest )
 {
-    interests_transmitted++;
-    interest_bytes_transmitted += interest.wireEncode().size();
+    // recorded on the face the interest came in on
+    uint64_t face = interest.getIncomingFaceId();
+    metrics.record( RoleRouter, MetricInterestsTransmitted, 1, face );
+    metrics.record( RoleRouter, MetricInterestBytesTransmitted,
+                    interest.wireSize(), face );
     
     if( interest.hasAuthTag() )
     {
-        tags_transmitted++;
-        tag_bytes_transmitted +=
-            interest.getAuthTag().wireEncode().size();
+        metrics.record( RoleRouter, MetricTagsTransmitted, 1, face );
+        metrics.record( RoleRouter, MetricTagBytesTransmitted,
+                        interest.getAuthTag().wireSize(), face );
     }
 }
 
@@ -569,8 +789,11 @@ void
 RouterSentDataCallback
 ( const Data& data )
 {
-    datas_transmitted++;
-    data_bytes_transmitted += data.wireEncode().size();
+    // recorded on the face the data came in on
+    uint64_t face = data.getIncomingFaceId();
+    metrics.record( RoleRouter, MetricDatasTransmitted, 1, face );
+    metrics.record( RoleRouter, MetricDataBytesTransmitted,
+                    data.wireSize(), face );
 }
 
 void
@@ -605,7 +828,18 @@ void
 EdgeAuthCachedCallback
 ( const AuthTag& tag, AuthCachedDetail detail )
 {
-    // NADA
+    switch( detail )
+    {
+        case CachedPositiveUpstream:
+            metrics.record( RoleEdge, MetricAuthCachedPositiveUpstream );
+            break;
+        case CachedPositiveMoved:
+            metrics.record( RoleEdge, MetricAuthCachedPositiveMoved );
+            break;
+        case CachedNegativeUpstream:
+            metrics.record( RoleEdge, MetricAuthCachedNegativeUpstream );
+            break;
+    }
 }
 
 void
@@ -615,13 +849,13 @@ EdgeBlockedInterestCallback
     switch( detail )
     {
         case BlockedExpired:
-            edge_blocked_expired++;
+            metrics.record( RoleEdge, MetricEdgeBlockedExpired );
             break;
         case BlockedBadPrefix:
-            edge_blocked_bad_prefix++;
+            metrics.record( RoleEdge, MetricEdgeBlockedBadPrefix );
             break;
         case BlockedBadRoute:
-            edge_blocked_bad_route++;
+            metrics.record( RoleEdge, MetricEdgeBlockedBadRoute );
             break;
     }
 }
@@ -630,24 +864,123 @@ void
 EdgeSigVerifCallback
 ( const AuthTag& tag, Time delay )
 {
-    sigverifs++;
-    sigverifs_delay += delay;
+    metrics.record( RoleEdge, MetricSigverifs );
+    metrics.record( RoleEdge, MetricSigverifsDelay,
+                    delay.GetNanoSeconds() );
+}
+
+void
+EdgeKeyContextCallback
+( const KeyLocator& locator, bool hit, Time delay )
+{
+    if( hit )
+        metrics.record( RoleEdge, MetricKeyContextHits );
+    else
+        metrics.record( RoleEdge, MetricKeyContextMisses );
+    metrics.record( RoleEdge, MetricKeyContextDelay,
+                    delay.GetNanoSeconds() );
 }
 
 void
 EdgeBloomLookupCallback
 ( const AuthTag& tag, Time delay )
 {
-    bloom_lookups++;
-    bloom_lookups_delay += delay;
+    metrics.record( RoleEdge, MetricBloomLookups );
+    metrics.record( RoleEdge, MetricBloomLookupsDelay,
+                    delay.GetNanoSeconds() );
+}
+
+void
+EdgeCacheLookupCallback
+( const AuthTag& tag, EdgeCacheKind cache, bool hit )
+{
+    switch( cache )
+    {
+        case EdgeCachePositive:
+            metrics.record( RoleEdge, hit ? MetricPositiveCacheHits
+                                          : MetricPositiveCacheMisses );
+            break;
+        case EdgeCacheNegative:
+            metrics.record( RoleEdge, hit ? MetricNegativeCacheHits
+                                          : MetricNegativeCacheMisses );
+            break;
+    }
 }
 
 void
 EdgeBloomInsertCallback
 ( const AuthTag& tag, Time delay )
 {
-    bloom_inserts++;
-    bloom_inserts_delay += delay;
+    metrics.record( RoleEdge, MetricBloomInserts );
+    metrics.record( RoleEdge, MetricBloomInsertsDelay,
+                    delay.GetNanoSeconds() );
+}
+
+void
+SpanCallback
+( uint32_t nonce, SpanKind kind, Time duration )
+{
+    if( !span_trace_stream.is_open() )
+        return;
+
+    auto it = pending_spans.find( nonce );
+    if( it == pending_spans.end() )
+    {
+        // drop the oldest requests to make room, an entry for a
+        // request that's since been answered ( or answered and
+        // reused ) no longer matches the pending one's order
+        while( pending_order.size() >= max_pending_spans )
+        {
+            auto oldest = pending_spans.find( pending_order.front().first );
+            if( oldest != pending_spans.end()
+              && oldest->second.order == pending_order.front().second )
+                pending_spans.erase( oldest );
+            pending_order.pop_front();
+        }
+
+        PendingSpans pending = {};
+        pending.order = next_pending_order++;
+        pending_order.emplace_back( nonce, pending.order );
+        it = pending_spans.emplace( nonce, pending ).first;
+    }
+    it->second.spans[kind] += duration.GetNanoSeconds();
+}
+
+void
+QueueingCallback
+( uint32_t nonce, Time queueing )
+{
+    SpanCallback( nonce, SpanQueueing, queueing );
+}
+
+void
+RequestCallback
+( uint32_t nonce, Time sent, Time received )
+{
+    if( !span_trace_stream.is_open() )
+        return;
+
+    SpanRecord record = {};
+    record.time    = received.GetNanoSeconds();
+    record.latency = ( received - sent ).GetNanoSeconds();
+    record.nonce   = nonce;
+
+    auto it = pending_spans.find( nonce );
+    if( it != pending_spans.end() )
+    {
+        copy( it->second.spans.begin(), it->second.spans.end(),
+              record.spans );
+        pending_spans.erase( it );
+    }
+
+    // whatever the other spans don't account
+    // for was spent on the links
+    int64_t accounted = 0;
+    for( size_t i = 0 ; i < SpanCount ; i++ )
+        accounted += record.spans[i];
+    record.spans[SpanLink] = max( record.latency - accounted, (int64_t)0 );
+
+    span_trace_stream.write( (const char*)&record, sizeof( record ) );
 }
 
 // loggers
@@ -657,8 +990,8 @@ TagsCreatedLogger( void )
     if( !tags_created_trace_stream.good() )
         return;
 
-    tags_created_trace_stream
-    << Simulator::Now() << '\t' << tags_created << endl;
+    writeRow( TraceTagsCreated, tags_created_trace_stream,
+              { countColumn( total( MetricTagsCreated ) ) } );
     
     tags_created_event = Simulator::Schedule
                         ( tags_created_trace_interval,
@@ -671,8 +1004,8 @@ TagsActiveLogger( void )
     if( !tags_active_trace_stream.good() )
         return;
 
-    tags_active_trace_stream
-    << Simulator::Now() << '\t' << tags_active << endl;
+    writeRow( TraceTagsActive, tags_active_trace_stream,
+              { countColumn( total( MetricTagsActive ) ) } );
     
     tags_active_event = Simulator::Schedule
                         ( tags_active_trace_interval,
@@ -684,9 +1017,12 @@ TagSigVerifLogger( void )
 {
     if( !tag_sigverif_trace_stream.good() )
         return;
-    tag_sigverif_trace_stream
-    << Simulator::Now() << '\t' << sigverifs
-                        << '\t' << sigverifs_delay << endl;
+    writeRow( TraceTagSigVerif, tag_sigverif_trace_stream,
+              { countColumn( total( MetricSigverifs ) ),
+                delayColumn( totalDelay( MetricSigverifsDelay ) ),
+                countColumn( total( MetricKeyContextHits ) ),
+                countColumn( total( MetricKeyContextMisses ) ),
+                delayColumn( totalDelay( MetricKeyContextDelay ) ) } );
     tag_sigverif_event = Simulator::Schedule
                          ( tag_sigverif_trace_interval,
                            &TagSigVerifLogger );
@@ -698,11 +1034,15 @@ TagBloomLogger( void )
     if( !tag_bloom_trace_stream.good() )
         return;
 
-    tag_bloom_trace_stream
-    << Simulator::Now() << '\t' << bloom_lookups
-                        << '\t' << bloom_lookups_delay
-                        << '\t' << bloom_inserts
-                        << '\t' << bloom_inserts_delay << endl;
+    writeRow( TraceTagBloom, tag_bloom_trace_stream,
+              { countColumn( total( MetricBloomLookups ) ),
+                delayColumn( totalDelay( MetricBloomLookupsDelay ) ),
+                countColumn( total( MetricBloomInserts ) ),
+                delayColumn( totalDelay( MetricBloomInsertsDelay ) ),
+                countColumn( total( MetricPositiveCacheHits ) ),
+                countColumn( total( MetricPositiveCacheMisses ) ),
+                countColumn( total( MetricNegativeCacheHits ) ),
+                countColumn( total( MetricNegativeCacheMisses ) ) } );
     tag_bloom_event = Simulator::Schedule
                      ( tag_bloom_trace_interval, &TagBloomLogger );
 }
@@ -713,21 +1053,20 @@ OverheadLogger( void )
     if( !overhead_trace_stream.good() )
         return;
 
-    Time delay = sigverifs_delay
-               + bloom_lookups_delay
-               + bloom_inserts_delay;
+    Time delay = totalDelay( MetricSigverifsDelay )
+               + totalDelay( MetricBloomLookupsDelay )
+               + totalDelay( MetricBloomInsertsDelay );
 
     // approximation
     uint64_t bytes = // 3 bytes for NoReCacheFlag
-                     datas_transmitted*3
+                     total( MetricDatasTransmitted )*3
                      // 5 bytes for AuthValidityProb
-                   + interests_transmitted*5
+                   + total( MetricInterestsTransmitted )*5
                      // auth tag overhead
-                   + tag_bytes_transmitted;
+                   + total( MetricTagBytesTransmitted );
     
-    overhead_trace_stream
-    << Simulator::Now() << '\t' << bytes << "bytes"
-                        << '\t' << delay << endl;
+    writeRow( TraceOverhead, overhead_trace_stream,
+              { bytesColumn( bytes ), delayColumn( delay ) } );
     overhead_event = Simulator::Schedule
                     ( overhead_trace_interval, &OverheadLogger );
 }
@@ -751,31 +1090,33 @@ ValidationLogger( void )
     if( !validation_trace_stream.good() )
         return;
 
-    uint64_t total_success = validations_success_sig
-                           + validations_success_valprob
-                           + validations_success_bloom
-                           + validations_success_skipped;
-   uint64_t total_failure  = validations_failure_sig
-                           + validations_failure_noauth
-                           + validations_failure_lowauth
-                           + validations_failure_badkeyloc
-                           + validations_failure_expired
-                           + validations_failure_badprefix;
-
-    validation_trace_stream
-    << Simulator::Now()  << '\t' << total_success
-                         << '\t' << validations_success_sig
-                         << '\t' << validations_success_valprob
-                         << '\t' << validations_success_bloom
-                         << '\t' << validations_success_skipped
-                         << '\t' << total_failure
-                         << '\t' << validations_failure_sig
-                         << '\t' << validations_failure_noauth
-                         << '\t' << validations_failure_lowauth
-                         << '\t' << validations_failure_badkeyloc
-                         << '\t' << validations_failure_expired
-                         << '\t' << validations_failure_badprefix
-                         << endl;
+    uint64_t total_success = total( MetricValidationsSuccessSig )
+                           + total( MetricValidationsSuccessValProb )
+                           + total( MetricValidationsSuccessBloom )
+                           + total( MetricValidationsSuccessSkipped )
+                           + total( MetricValidationsSuccessMemo );
+   uint64_t total_failure  = total( MetricValidationsFailureSig )
+                           + total( MetricValidationsFailureNoAuth )
+                           + total( MetricValidationsFailureLowAuth )
+                           + total( MetricValidationsFailureBadKeyLoc )
+                           + total( MetricValidationsFailureExpired )
+                           + total( MetricValidationsFailureBadPrefix );
+
+    writeRow( TraceValidation, validation_trace_stream,
+              { countColumn( total_success ),
+                countColumn( total( MetricValidationsSuccessSig ) ),
+                countColumn( total( MetricValidationsSuccessValProb ) ),
+                countColumn( total( MetricValidationsSuccessBloom ) ),
+                countColumn( total( MetricValidationsSuccessSkipped ) ),
+                countColumn( total_failure ),
+                countColumn( total( MetricValidationsFailureSig ) ),
+                countColumn( total( MetricValidationsFailureNoAuth ) ),
+                countColumn( total( MetricValidationsFailureLowAuth ) ),
+                countColumn( total( MetricValidationsFailureBadKeyLoc ) ),
+                countColumn( total( MetricValidationsFailureExpired ) ),
+                countColumn( total( MetricValidationsFailureBadPrefix ) ),
+                // appended so the earlier columns keep their positions
+                countColumn( total( MetricValidationsSuccessMemo ) ) } );
     validation_event = Simulator::Schedule
                       ( validation_trace_interval,
                         &ValidationLogger );
@@ -787,14 +1128,13 @@ TransmissionLogger( void )
     if( !transmission_trace_stream.good() )
         return;
 
-    transmission_trace_stream
-    << Simulator::Now() << '\t' << datas_transmitted 
-                        << '\t' << data_bytes_transmitted
-                        << '\t' << interests_transmitted
-                        << '\t' << interest_bytes_transmitted
-                        << '\t' << data_bytes_transmitted
-                                 + interest_bytes_transmitted
-                        << endl;
+    writeRow( TraceTransmission, transmission_trace_stream,
+              { countColumn( total( MetricDatasTransmitted ) ),
+                countColumn( total( MetricDataBytesTransmitted ) ),
+                countColumn( total( MetricInterestsTransmitted ) ),
+                countColumn( total( MetricInterestBytesTransmitted ) ),
+                countColumn( total( MetricDataBytesTransmitted )
+                           + total( MetricInterestBytesTransmitted ) ) } );
     transmission_event = Simulator::Schedule
                         ( transmission_trace_interval,
                           &TransmissionLogger );
@@ -806,12 +1146,11 @@ EdgeBlockLogger( void )
     if( !edgeblock_trace_stream.good() )
         return;
 
-    edgeblock_trace_stream
-    << Simulator::Now() << '\t' << edge_blocked_expired
-                        << '\t' << edge_blocked_bad_prefix
-                        << '\t' << edge_blocked_expired
-                                 + edge_blocked_bad_prefix
-                        << endl;
+    writeRow( TraceEdgeBlock, edgeblock_trace_stream,
+              { countColumn( total( MetricEdgeBlockedExpired ) ),
+                countColumn( total( MetricEdgeBlockedBadPrefix ) ),
+                countColumn( total( MetricEdgeBlockedExpired )
+                           + total( MetricEdgeBlockedBadPrefix ) ) } );
     edgeblock_event = Simulator::Schedule
                      ( edgeblock_trace_interval, &EdgeBlockLogger );
 }
@@ -822,24 +1161,54 @@ ConsumerLogger( void )
     if( !consumer_trace_stream.good() )
         return;
 
-    consumer_trace_stream
-    << Simulator::Now() << '\t' << consumer_requested
-                        << '\t' << consumer_received
-                        << '\t' << consumer_denied
-                        << '\t' << consumer_deserved
-                        << '\t' << consumer_undeserved
-                        << '\t' << consumer_unrequested
-                        << '\t' << consumer_retx
-                        << '\t' << consumer_timeout
-                        << '\t' << consumer_partial_delay
-                                   / consumer_received
-                        << '\t' << consumer_delay
-                                   / consumer_received
-                        << endl;
+    // the network wide histograms are merged from those of
+    // each consumer, which start over for the next interval
+    LatencyHistogram delay;
+    LatencyHistogram partial_delay;
+    for( auto& it : consumer_latencies )
+    {
+        delay.merge( it.second.delay );
+        partial_delay.merge( it.second.partial_delay );
+        it.second.delay.reset();
+        it.second.partial_delay.reset();
+    }
+
+    writeRow( TraceConsumer, consumer_trace_stream,
+              { countColumn( total( MetricConsumerRequested ) ),
+                countColumn( total( MetricConsumerReceived ) ),
+                countColumn( total( MetricConsumerDenied ) ),
+                countColumn( total( MetricConsumerDeserved ) ),
+                countColumn( total( MetricConsumerUndeserved ) ),
+                countColumn( total( MetricConsumerUnrequested ) ),
+                countColumn( total( MetricConsumerRetx ) ),
+                countColumn( total( MetricConsumerTimeout ) ),
+                delayColumn( totalDelay( MetricConsumerPartialDelay )
+                             / total( MetricConsumerReceived ) ),
+                delayColumn( totalDelay( MetricConsumerDelay )
+                             / total( MetricConsumerReceived ) ),
+                delayColumn( NanoSeconds( partial_delay.percentile( 50 ) ) ),
+                delayColumn( NanoSeconds( partial_delay.percentile( 90 ) ) ),
+                delayColumn( NanoSeconds( partial_delay.percentile( 99 ) ) ),
+                delayColumn( NanoSeconds( partial_delay.percentile( 99.9 ) ) ),
+                delayColumn( NanoSeconds( delay.percentile( 50 ) ) ),
+                delayColumn( NanoSeconds( delay.percentile( 90 ) ) ),
+                delayColumn( NanoSeconds( delay.percentile( 99 ) ) ),
+                delayColumn( NanoSeconds( delay.percentile( 99.9 ) ) ) } );
     consumer_event = Simulator::Schedule
                      ( consumer_trace_interval, &ConsumerLogger );
 }
 
+void
+MetricsLogger( void )
+{
+    if( !metrics_trace_stream.good() )
+        return;
+
+    metrics.writeSample( metrics_trace_stream, Simulator::Now() );
+    metrics_event = Simulator::Schedule
+                    ( metrics_trace_interval, &MetricsLogger );
+}
+
 // initialization and finalization
 struct Setup
 {
@@ -849,6 +1218,7 @@ Setup( void )
     consumer = CreateObject< ConsumerTrace >();
     router   = CreateObject< RouterTrace >();
     edge     = CreateObject< EdgeTrace >();
+    spans    = CreateObject< SpanTrace >();
     
     producer->TraceConnectWithoutContext
     ( "TagCreatedTrace",
@@ -908,6 +1278,9 @@ Setup( void )
     ( "SigVerifTrace",
       MakeCallback( &RouterSigVerifCallback ) );
     router->TraceConnectWithoutContext
+    ( "KeyContextTrace",
+      MakeCallback( &RouterKeyContextCallback ) );
+    router->TraceConnectWithoutContext
     ( "BloomLookupTrace",
       MakeCallback( &RouterBloomLookupCallback ) );
     router->TraceConnectWithoutContext
@@ -927,9 +1300,15 @@ Setup( void )
     ( "SigVerifTrace",
       MakeCallback( &EdgeSigVerifCallback ) );
     edge->TraceConnectWithoutContext
+    ( "KeyContextTrace",
+      MakeCallback( &EdgeKeyContextCallback ) );
+    edge->TraceConnectWithoutContext
     ( "BloomLookupTrace",
       MakeCallback( &EdgeBloomLookupCallback ) );
     edge->TraceConnectWithoutContext
+    ( "CacheLookupTrace",
+      MakeCallback( &EdgeCacheLookupCallback ) );
+    edge->TraceConnectWithoutContext
     ( "BloomInsertTrace",
       MakeCallback( &EdgeBloomInsertCallback ) );
     edge->TraceConnectWithoutContext
@@ -950,6 +1329,13 @@ Setup( void )
     edge->TraceConnectWithoutContext
     ( "BlockedInterestTrace",
       MakeCallback( &EdgeBlockedInterestCallback ) );
+    
+    spans->TraceConnectWithoutContext
+    ( "SpanTrace",
+      MakeCallback( &SpanCallback ) );
+    spans->TraceConnectWithoutContext
+    ( "RequestTrace",
+      MakeCallback( &RequestCallback ) );
 };
 
 ~Setup( void )
@@ -963,6 +1349,10 @@ Setup( void )
     //rate_trace_stream.close();
     validation_trace_stream.close();
     transmission_trace_stream.close();
+    metrics_trace_stream.close();
+    span_trace_stream.close();
+    consumer_trace_stream.close();
+    edgeblock_trace_stream.close();
     
     Simulator::Cancel( tags_created_event );
     Simulator::Cancel( tags_active_event );
@@ -971,19 +1361,32 @@ Setup( void )
     Simulator::Cancel( overhead_event );
     Simulator::Cancel( validation_event );
     Simulator::Cancel( transmission_event );
+    Simulator::Cancel( metrics_event );
+    Simulator::Cancel( consumer_event );
+    Simulator::Cancel( edgeblock_event );
+
+    // writes out whatever is still buffered
+    binary_sink.reset();
 };
 };
 Setup setup;
 
 // initializers
+void
+EnableBinaryTraces
+( const string& logfile )
+{
+    binary_sink.reset( new TraceSink( logfile ) );
+    if( !binary_sink->good() )
+        binary_sink.reset();
+}
+
 void
 EnableTagsCreatedTrace
 ( const string& logfile,
   Time interval )
 {
-    tags_created_trace_stream.open( logfile );
-    if( !tags_created_trace_stream.good() )
-        cerr << "Error opening log file '" << logfile << "'" << endl;
+    openTrace( tags_created_trace_stream, logfile, TraceTagsCreated );
     tags_created_trace_interval = interval;
 
     tags_created_event =
@@ -995,9 +1398,7 @@ EnableTagsActiveTrace
 ( const string& logfile,
   Time interval )
 {
-    tags_active_trace_stream.open( logfile );
-    if( !tags_active_trace_stream.good() )
-        cerr << "Error opening log file '" << logfile << "'" << endl;
+    openTrace( tags_active_trace_stream, logfile, TraceTagsActive );
     tags_active_trace_interval = interval;
 
     tags_active_event =
@@ -1010,9 +1411,7 @@ EnableTagSigVerifTrace
 ( const string& logfile,
   Time interval )
 {
-    tag_sigverif_trace_stream.open( logfile );
-    if( !tag_sigverif_trace_stream.good() )
-        cerr << "Error opening log file '" << logfile << "'" << endl;
+    openTrace( tag_sigverif_trace_stream, logfile, TraceTagSigVerif );
     tag_sigverif_trace_interval = interval;
 
     tag_sigverif_event =
@@ -1025,9 +1424,7 @@ EnableTagBloomTrace
 ( const string& logfile,
   Time interval )
 {
-    tag_bloom_trace_stream.open( logfile );
-    if( !tag_bloom_trace_stream.good() )
-        cerr << "Error opening log file '" << logfile << "'" << endl;
+    openTrace( tag_bloom_trace_stream, logfile, TraceTagBloom );
     tag_bloom_trace_interval = interval;
 
     tag_bloom_event =
@@ -1040,9 +1437,7 @@ EnableOverheadTrace
 ( const string& logfile,
   Time interval )
 {
-    overhead_trace_stream.open( logfile );
-    if( !overhead_trace_stream.good() )
-        cerr << "Error opening log file '" << logfile << "'" << endl;
+    openTrace( overhead_trace_stream, logfile, TraceOverhead );
     overhead_trace_interval = interval;
 
     overhead_event =
@@ -1073,9 +1468,7 @@ EnableValidationTrace
 ( const string& logfile,
   Time interval )
 {
-    validation_trace_stream.open( logfile );
-    if( !validation_trace_stream.good() )
-        cerr << "Error opening log file '" << logfile << "'" << endl;
+    openTrace( validation_trace_stream, logfile, TraceValidation );
     validation_trace_interval = interval;
 
     validation_event =
@@ -1088,9 +1481,7 @@ EnableTransmissionTrace
 ( const string& logfile,
   Time interval )
 {
-    transmission_trace_stream.open( logfile );
-    if( !transmission_trace_stream.good() )
-        cerr << "Error opening log file '" << logfile << "'" << endl;
+    openTrace( transmission_trace_stream, logfile, TraceTransmission );
     transmission_trace_interval = interval;
 
     transmission_event =
@@ -1103,9 +1494,7 @@ EnableEdgeBlockTrace
 ( const string& logfile,
   Time interval )
 {
-    edgeblock_trace_stream.open( logfile );
-    if( !edgeblock_trace_stream.good() )
-        cerr << "Error opening log file '" << logfile << "'" << endl;
+    openTrace( edgeblock_trace_stream, logfile, TraceEdgeBlock );
     edgeblock_trace_interval = interval;
 
     edgeblock_event =
@@ -1117,27 +1506,98 @@ EnableConsumerTrace
 ( const string& logfile,
   Time interval )
 {
-    consumer_trace_stream.open( logfile );
-    if( !consumer_trace_stream.good() )
-        cerr << "Error opening log file '" << logfile << "'" << endl;
+    openTrace( consumer_trace_stream, logfile, TraceConsumer );
     consumer_trace_interval = interval;
-    
-    consumer_trace_stream
-    << "# 1. Time\n"
-    << "# 2. Number of interests sent by all consumers\n"
-    << "# 3. Number of datas received by all consumers\n"
-    << "# 4. Number of nacks received by all consumers\n"
-    << "# 5. Number of wrongful nacks\n"
-    << "# 6. Number of wrongful datas\n"
-    << "# 7. Number of unrequested datas\n"
-    << "# 8. Number of retransmissions\n"
-    << "# 9. Number of timeouts\n"
-    << "# 10. Average delay between last retx and data receipt\n"
-    << "# 11. Average delay between initial tx and data receipt\n";
 
     consumer_event =
         Simulator::Schedule( interval, &ConsumerLogger );
 }
 
+void
+EnableMetricsTrace
+( const string& logfile,
+  Time interval )
+{
+    metrics_trace_stream.open( logfile );
+    if( !metrics_trace_stream.good() )
+        cerr << "Error opening log file '" << logfile << "'" << endl;
+    metrics_trace_interval = interval;
+
+    // rows for every role and a few faces of each node,
+    // so recording rarely has to grow the columns
+    metrics.reserve( NodeList::GetNNodes() * RoleCount * 4 );
+    metrics.writeHeader( metrics_trace_stream );
+
+    metrics_event =
+        Simulator::Schedule( interval, &MetricsLogger );
+}
+
+void
+EnableSpanTrace
+( const string& logfile )
+{
+    span_trace_stream.open( logfile, ios::out | ios::binary );
+    if( !span_trace_stream.good() )
+    {
+        cerr << "Error opening log file '" << logfile << "'" << endl;
+        span_trace_stream.close();
+        return;
+    }
+
+    TxQueue::queueingTrace().ConnectWithoutContext
+    ( MakeCallback( &QueueingCallback ) );
+}
+
+bool
+ConvertBinaryTraces
+( const string& logfile,
+  const string& directory )
+{
+    ifstream in( logfile, ios::in | ios::binary );
+    if( !in.good() )
+    {
+        cerr << "Error opening log file '" << logfile << "'" << endl;
+        return false;
+    }
+
+    // the records of a row are always written together,
+    // so a row ends where the next one's first column is
+    ofstream out[TraceCount];
+    int open_row = -1;
+    TraceRecord record;
+    while( TraceSink::read( in, record ) )
+    {
+        if( record.trace >= TraceCount )
+            continue;
+
+        ofstream& os = out[record.trace];
+        if( !os.is_open() )
+        {
+            string file = directory + "/"
+                        + trace_layouts[record.trace].file;
+            os.open( file );
+            if( !os.good() )
+            {
+                cerr << "Error opening log file '" << file << "'" << endl;
+                return false;
+            }
+            os << trace_layouts[record.trace].header;
+        }
+
+        if( record.column == 0 )
+        {
+            if( open_row >= 0 )
+                out[open_row] << '\n';
+            os << NanoSeconds( record.time );
+            open_row = record.trace;
+        }
+        os << '\t';
+        writeValue( os, (TraceValueKind)record.kind, record.value );
+    }
+    if( open_row >= 0 )
+        out[open_row] << '\n';
+    return true;
+}
+
 };
 };
@@ -27,6 +27,7 @@ enum ValidationDetail
     ValidationSuccessBloom,
     ValidationSuccessSig,
     ValidationSuccessSkipped,
+    ValidationSuccessMemo,
     ValidationFailureSig,
     ValidationFailureNoAuth,
     ValidationFailureLowAuth,
@@ -43,6 +44,13 @@ enum AuthCachedDetail
     CachedNegativeUpstream
 };
 
+// auth caches of an edge router
+enum EdgeCacheKind
+{
+    EdgeCachePositive,
+    EdgeCacheNegative
+};
+
 enum BlockedDetail
 {
     BlockedExpired,
@@ -50,6 +58,35 @@ enum BlockedDetail
     BlockedBadRoute
 };
 
+// parts of a request's latency traced by the span trace
+enum SpanKind
+{
+    SpanEdgeBloom,
+    SpanEdgeSigVerif,
+    SpanRouterBloom,
+    SpanRouterSigVerif,
+    SpanProducerSigVerif,
+    SpanQueueing,
+    SpanLink,           // what's left of the request's latency
+    SpanCount
+};
+
+// the interval traces, in the order of the Enable functions;
+// binary trace records identify their trace by these
+enum TraceId
+{
+    TraceTagsCreated,
+    TraceTagsActive,
+    TraceTagSigVerif,
+    TraceTagBloom,
+    TraceOverhead,
+    TraceValidation,
+    TraceTransmission,
+    TraceEdgeBlock,
+    TraceConsumer,
+    TraceCount
+};
+
 
 // tracers
 struct ProducerTrace : ns3::Object
@@ -156,6 +193,10 @@ struct RouterTrace : ns3::Object
     < const ndn::AuthTag&, ns3::Time /*delay*/>
     sigverif;
     
+    ns3::TracedCallback
+    < const ndn::KeyLocator&, bool /*hit*/, ns3::Time /*delay*/>
+    key_context;
+    
     ns3::TracedCallback
     < const ndn::AuthTag&, ns3::Time /*delay*/>
     bloom_lookup;
@@ -219,11 +260,21 @@ struct EdgeTrace : ns3::Object
     < const ndn::AuthTag&, ns3::Time /*delay*/>
     sigverif;
     
+    // key context looked up, loaded on a miss
+    ns3::TracedCallback
+    < const ndn::KeyLocator&, bool /*hit*/, ns3::Time /*delay*/>
+    key_context;
+    
     // bloom lookup occured
     ns3::TracedCallback
     < const ndn::AuthTag&, ns3::Time /*delay*/>
     bloom_lookup;
     
+    // result of a bloom lookup, and which cache was looked in
+    ns3::TracedCallback
+    < const ndn::AuthTag&, EdgeCacheKind, bool /*hit*/>
+    cache_lookup;
+    
     // bloom insert occured
     ns3::TracedCallback
     < const ndn::AuthTag&, ns3::Time /*delay*/>
@@ -231,6 +282,25 @@ struct EdgeTrace : ns3::Object
 };
 extern ns3::Ptr< EdgeTrace > edge;
 
+// tracers
+struct SpanTrace : ns3::Object
+{
+    static ns3::TypeId
+    GetTypeId( void );
+    
+    // some part of a request's latency, the request is
+    // identified by its interest's nonce
+    ns3::TracedCallback
+    < uint32_t /*nonce*/, SpanKind, ns3::Time /*duration*/ >
+    span;
+    
+    // a request was answered
+    ns3::TracedCallback
+    < uint32_t /*nonce*/, ns3::Time /*sent*/, ns3::Time /*received*/ >
+    request;
+};
+extern ns3::Ptr< SpanTrace > spans;
+
 
 
 // traces the total number of tags
@@ -248,7 +318,8 @@ EnableTagsActiveTrace
   ns3::Time interval );
 
 // traces the total number of signature
-// verifications
+// verifications, and key context cache
+// hits and misses
 void
 EnableTagSigVerifTrace
 ( const std::string& logfile,
@@ -313,6 +384,36 @@ EnableConsumerTrace
 ( const std::string& logfile,
   ns3::Time interval );
 
+// writes a fixed size binary record for each request
+// answered, with the request's latency split by span
+// kind; see SpanRecord in tracers.cpp for the layout
+void
+EnableSpanTrace
+( const std::string& logfile );
+
+// writes the rows of all the interval traces enabled
+// after this as records to one buffered binary file,
+// instead of a text file per trace; the logfile passed
+// to each trace is ignored
+void
+EnableBinaryTraces
+( const std::string& logfile );
+
+// converts a binary trace back into the text files
+// of the interval traces, written to the directory
+bool
+ConvertBinaryTraces
+( const std::string& logfile,
+  const std::string& directory );
+
+// writes every counter kept by the tracers, per
+// node, face and role, as csv; one row per node,
+// face and role at each interval
+void
+EnableMetricsTrace
+( const std::string& logfile,
+  ns3::Time interval );
+
 
 };
 };
@@ -0,0 +1,172 @@
+/**
+* @class ndntac::ValidationMemo
+* A memo of the data an AuthTag has already been validated for.
+*
+* Entries are keyed by the tag's fingerprint, the data's content
+* prefix ( its name without the last component, usually a segment
+* number ) and the data's access level.  A tag that's been verified
+* for one segment of some content is then accepted for all the
+* other segments without verifying its signature again.  Entries
+* are only valid until their tag expires.
+*
+* The memo holds at most a configured number of entries; when it's
+* full expired entries are purged, and new entries are dropped if
+* that doesn't make room.
+**/
+
+#ifndef VALIDATION_MEMO_INCLUDED
+#define VALIDATION_MEMO_INCLUDED
+
+#include "ndn-cxx/auth-tag.hpp"
+#include "ndn-cxx/data.hpp"
+#include <boost/functional/hash.hpp>
+#include <cstdint>
+#include <unordered_map>
+
+namespace ndntac
+{
+
+  class ValidationMemo
+  {
+  private:
+    struct Key
+    {
+      uint64_t fingerprint[2];
+      size_t   prefix_hash;
+      uint8_t  access_level;
+
+      bool operator==( const Key& other ) const
+      {
+        return fingerprint[0] == other.fingerprint[0]
+            && fingerprint[1] == other.fingerprint[1]
+            && prefix_hash == other.prefix_hash
+            && access_level == other.access_level;
+      }
+    };
+
+    struct KeyHash
+    {
+      size_t operator()( const Key& key ) const
+      {
+        // the fingerprint is already a good hash
+        size_t seed = key.fingerprint[0];
+        boost::hash_combine( seed, key.prefix_hash );
+        boost::hash_combine( seed, key.access_level );
+        return seed;
+      }
+    };
+
+    // expiration in milliseconds since the epoch
+    std::unordered_map< Key, int64_t, KeyHash > m_entries;
+    size_t                                     m_max_size;
+
+  public:
+
+    /**
+    * @brief Constructor
+    * @param n  Max number of entries, 0 disables the memo
+    **/
+    ValidationMemo( size_t n )
+      : m_max_size( n )
+    { }
+
+    /**
+    * @brief Remember that the tag has been validated for the data
+    **/
+    void insert( const ndn::AuthTag& tag, const ndn::Data& data )
+    {
+      if( m_max_size == 0 )
+        return;
+
+      int64_t expiration = INT64_MAX;
+      try
+      {
+        expiration = ndn::time::toUnixTimestamp
+                     ( tag.getExpirationTime() ).count();
+      }
+      catch( ... )
+      {
+        // tags without a validity period never expire
+      }
+
+      if( m_entries.size() >= m_max_size )
+      {
+        purge();
+        if( m_entries.size() >= m_max_size )
+          return;
+      }
+      m_entries[ makeKey( tag, data ) ] = expiration;
+    }
+
+    /**
+    * @brief Check if the tag has been validated for the data
+    * @return true if it has, and the tag hasn't expired since
+    **/
+    bool contains( const ndn::AuthTag& tag, const ndn::Data& data )
+    {
+      if( m_entries.empty() )
+        return false;
+
+      auto it = m_entries.find( makeKey( tag, data ) );
+      if( it == m_entries.end() )
+        return false;
+      if( it->second < now() )
+      {
+        m_entries.erase( it );
+        return false;
+      }
+      return true;
+    }
+
+    size_t size() const
+    {
+      return m_entries.size();
+    }
+
+  private:
+
+    static Key makeKey( const ndn::AuthTag& tag, const ndn::Data& data )
+    {
+      const uint64_t* fp = tag.getFingerprint();
+      return Key{ { fp[0], fp[1] },
+                  hashContentPrefix( data.getName() ),
+                  data.getAccessLevel() };
+    }
+
+    /**
+    * @brief Hash the wire encoding of all but the name's last
+    *        component, which is contiguous in the name's wire
+    **/
+    static size_t hashContentPrefix( const ndn::Name& name )
+    {
+      if( name.size() < 2 )
+        return 0;
+
+      name.wireEncode();
+      const uint8_t* begin = name.get( 0 ).wire();
+      const uint8_t* end = name.get( -1 ).wire();
+      return boost::hash_range( begin, end );
+    }
+
+    void purge()
+    {
+      int64_t now_ms = now();
+      for( auto it = m_entries.begin() ; it != m_entries.end() ; )
+      {
+        if( it->second < now_ms )
+          it = m_entries.erase( it );
+        else
+          ++it;
+      }
+    }
+
+    static int64_t now()
+    {
+      return ndn::time::toUnixTimestamp
+             ( ndn::time::system_clock::now() ).count();
+    }
+  };
+
+};
+
+#endif // VALIDATION_MEMO_INCLUDED
@@ -51,6 +51,21 @@ struct Config
     
     Time simulation_time; // how much time to simulate
     
+    // if set routes are calculated on a thread pool with
+    // GlobalRoutingHelper::CalculateRoutesInParallel; the
+    // routes are equally short, but ties between equal cost
+    // paths may be broken differently than CalculateRoutes
+    bool parallel_routes;
+    
+    // if set the interval traces are written to this
+    // binary file, instead of a text file per trace;
+    // convert it with the convert-traces program
+    string binary_trace;
+    
+    // if set a record with the latency breakdown of
+    // each answered request is written to this file
+    string span_trace;
+    
     // enables trace that keeps track of total number of
     // auth tags that have been created at each interval in
     // the simulation
@@ -190,9 +205,14 @@ int main( int argc, char* argv[] )
     }
 
     // configure routes
-    GlobalRoutingHelper::CalculateRoutes();
+    if( config.parallel_routes )
+        GlobalRoutingHelper::CalculateRoutesInParallel();
+    else
+        GlobalRoutingHelper::CalculateRoutes();
     
     
+    if( !config.binary_trace.empty() )
+        tracers::EnableBinaryTraces( config.binary_trace );
     tracers::EnableTagsCreatedTrace
     ( "results/tags-created-trace.txt", Seconds( 1 ) );
     tracers::EnableTagsActiveTrace
@@ -215,6 +235,10 @@ int main( int argc, char* argv[] )
     ( "results/edgeblock-trace.txt", Seconds( 1 ) );
     tracers::EnableConsumerTrace
     ( "results/consumer-trace.txt", Seconds( 1 ) );
+    tracers::EnableMetricsTrace
+    ( "results/metrics-trace.csv", Seconds( 1 ) );
+    if( !config.span_trace.empty() )
+        tracers::EnableSpanTrace( config.span_trace );
     Simulator::Stop( config.simulation_time );
     Simulator::Run();
     Simulator::Destroy();
@@ -238,6 +262,9 @@ Config::Config( const string& file  )
     router_config   = "config/router_config.jx9";
     edge_config     = "config/edge_config.jx9";
     simulation_time = Seconds( 10 );
+    parallel_routes = false;
+    binary_trace    = "";
+    span_trace      = "";
     enable_tags_created_trace   = false;
     tags_created_trace_interval = Seconds(10);
     enable_tags_active_trace    = false;
@@ -358,6 +385,24 @@ Config::Config( const string& file  )
        edge_config.assign( str_val, str_len );
     }
     
+    val = unqlite_vm_extract_variable( vm, "parallel_routes" );
+    if( val && unqlite_value_is_bool( val ) )
+        parallel_routes = unqlite_value_to_bool( val );
+    
+    val = unqlite_vm_extract_variable( vm, "binary_trace" );
+    if( val && unqlite_value_is_string( val ) )
+    {
+       str_val = unqlite_value_to_string( val, &str_len );
+       binary_trace.assign( str_val, str_len );
+    }
+    
+    val = unqlite_vm_extract_variable( vm, "span_trace" );
+    if( val && unqlite_value_is_string( val ) )
+    {
+       str_val = unqlite_value_to_string( val, &str_len );
+       span_trace.assign( str_val, str_len );
+    }
+    
     val = unqlite_vm_extract_variable( vm, "simulation_time" );
     if( val && unqlite_value_is_float( val ) )
         simulation_time = Seconds( unqlite_value_to_double( val ) );
@@ -0,0 +1,28 @@
+/**
+* @brief Binary trace converter
+* Converts a binary trace written by a simulation with
+* $binary_trace set back into the usual text traces.
+*
+* Usage: convert-traces [binary trace] [output directory]
+**/
+
+#include "ns3/core-module.h"
+#include "tracers.hpp"
+#include <iostream>
+
+using namespace std;
+using namespace ndntac;
+
+int main( int argc, char* argv[] )
+{
+    string logfile   = "results/traces.bin";
+    string directory = "results";
+    if( argc > 1 )
+        logfile = argv[1];
+    if( argc > 2 )
+        directory = argv[2];
+
+    if( !tracers::ConvertBinaryTraces( logfile, directory ) )
+        return 1;
+    return 0;
+};
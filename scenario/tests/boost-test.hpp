@@ -0,0 +1,15 @@
+/**
+* Boost.Test for the extensions' unit tests, see the tests
+* of ndnSIM.
+**/
+
+#ifndef TESTS_BOOST_TEST_INCLUDED
+#define TESTS_BOOST_TEST_INCLUDED
+
+// suppress warnings from Boost.Test
+#pragma GCC system_header
+#pragma clang system_header
+
+#include <boost/test/unit_test.hpp>
+
+#endif // TESTS_BOOST_TEST_INCLUDED
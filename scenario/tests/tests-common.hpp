@@ -0,0 +1,51 @@
+/**
+* Fixtures shared by the extensions' unit tests.
+**/
+
+#ifndef TESTS_COMMON_INCLUDED
+#define TESTS_COMMON_INCLUDED
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <dirent.h>
+#include <unistd.h>
+
+namespace ndntac
+{
+
+  // a temporary directory for the files written by a test,
+  // removed along with its files when the test ends
+  struct TempDirFixture
+  {
+    TempDirFixture()
+    {
+      char path[] = "/tmp/ndntac-tests-XXXXXX";
+      if( !mkdtemp( path ) )
+        throw std::runtime_error( "can't create a temporary directory" );
+      dir = path;
+    }
+
+    ~TempDirFixture()
+    {
+      DIR* d = opendir( dir.c_str() );
+      if( d )
+      {
+        while( dirent* entry = readdir( d ) )
+        {
+          std::string name = entry->d_name;
+          if( name != "." && name != ".." )
+            std::remove( ( dir + "/" + name ).c_str() );
+        }
+        closedir( d );
+      }
+      rmdir( dir.c_str() );
+    }
+
+    std::string dir;
+  };
+
+};
+
+#endif // TESTS_COMMON_INCLUDED
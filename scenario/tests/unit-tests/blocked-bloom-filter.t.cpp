@@ -0,0 +1,95 @@
+#include "blocked-bloom-filter.hpp"
+#include "boost-test.hpp"
+#include <random>
+#include <vector>
+
+namespace ndntac
+{
+
+namespace
+{
+
+bloom_parameters
+makeParams( unsigned long long int n, double fpp )
+{
+    bloom_parameters params;
+    params.projected_element_count = n;
+    params.false_positive_probability = fpp;
+    params.compute_optimal_parameters();
+    return params;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( TestBlockedBloomFilter )
+
+BOOST_AUTO_TEST_CASE( NoFalseNegatives )
+{
+    BlockedBloomFilter filter( makeParams( 10000, 0.01 ) );
+    std::mt19937_64 rng( 1 );
+    std::vector< std::pair< uint64_t, uint64_t > > keys;
+    for( int i = 0 ; i < 10000 ; i++ )
+    {
+        keys.emplace_back( rng(), rng() );
+        filter.insert_digest( keys.back().first, keys.back().second );
+    }
+
+    for( const auto& key : keys )
+        BOOST_CHECK( filter.contains_digest( key.first, key.second ) );
+    BOOST_CHECK_EQUAL( filter.element_count(), 10000 );
+}
+
+BOOST_AUTO_TEST_CASE( FalsePositiveRate )
+{
+    // the table is sized so the blocked fpp meets the bound
+    // at the projected element count
+    BlockedBloomFilter filter( makeParams( 10000, 0.01 ) );
+    std::mt19937_64 rng( 2 );
+    for( int i = 0 ; i < 10000 ; i++ )
+        filter.insert_digest( rng(), rng() );
+    BOOST_CHECK_LE( filter.effective_fpp(), 0.01 );
+
+    int positives = 0;
+    const int trials = 100000;
+    for( int i = 0 ; i < trials ; i++ )
+    {
+        if( filter.contains_digest( rng(), rng() ) )
+            positives++;
+    }
+    BOOST_CHECK_LE( (double)positives/trials, 0.015 );
+}
+
+BOOST_AUTO_TEST_CASE( EffectiveFppGrows )
+{
+    BlockedBloomFilter filter( makeParams( 1000, 0.01 ) );
+    BOOST_CHECK_EQUAL( filter.effective_fpp(), 0 );
+
+    std::mt19937_64 rng( 3 );
+    double last = 0;
+    for( int i = 0 ; i < 4 ; i++ )
+    {
+        for( int j = 0 ; j < 500 ; j++ )
+            filter.insert_digest( rng(), rng() );
+        BOOST_CHECK_GT( filter.effective_fpp(), last );
+        last = filter.effective_fpp();
+    }
+
+    // over filled, so it's past the bound
+    BOOST_CHECK_GT( last, 0.01 );
+}
+
+BOOST_AUTO_TEST_CASE( Clear )
+{
+    BlockedBloomFilter filter( makeParams( 100, 0.01 ) );
+    filter.insert_digest( 1, 2 );
+    BOOST_CHECK( filter.contains_digest( 1, 2 ) );
+
+    filter.clear();
+    BOOST_CHECK( !filter.contains_digest( 1, 2 ) );
+    BOOST_CHECK_EQUAL( filter.element_count(), 0 );
+    BOOST_CHECK_EQUAL( filter.effective_fpp(), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};
@@ -0,0 +1,79 @@
+#include "tracers.hpp"
+#include "trace-sink.hpp"
+#include "tests-common.hpp"
+#include "boost-test.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace ndntac
+{
+namespace tracers
+{
+
+namespace
+{
+
+std::string
+readFile( const std::string& file )
+{
+    std::ifstream in( file );
+    std::ostringstream os;
+    os << in.rdbuf();
+    return os.str();
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE( TestConvertBinaryTraces, TempDirFixture )
+
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    // rows of two traces written interleaved, the way
+    // writeRow pushes them when binary traces are enabled
+    {
+        TraceSink sink( dir + "/traces.bin" );
+        sink.push( TraceRecord{ 1000000000, 5,
+                                TraceTagsCreated, 0, ValueCount, 0 } );
+        sink.push( TraceRecord{ 1000000000, 7,
+                                TraceConsumer, 0, ValueCount, 0 } );
+        sink.push( TraceRecord{ 1000000000, 2500,
+                                TraceConsumer, 1, ValueDelay, 0 } );
+        sink.push( TraceRecord{ 2000000000, 6,
+                                TraceTagsCreated, 0, ValueCount, 0 } );
+        sink.push( TraceRecord{ 2000000000, 1024,
+                                TraceTagsCreated, 1, ValueBytes, 0 } );
+    }
+
+    BOOST_REQUIRE( ConvertBinaryTraces( dir + "/traces.bin", dir ) );
+
+    // the text traces print times and delays as ns3::Time
+    std::ostringstream tags_created;
+    tags_created << ns3::NanoSeconds( 1000000000 ) << "\t5\n"
+                 << ns3::NanoSeconds( 2000000000 ) << "\t6\t1024bytes\n";
+    BOOST_CHECK_EQUAL( readFile( dir + "/tags-created-trace.txt" ),
+                       tags_created.str() );
+
+    // the consumer trace starts with its header
+    std::string consumer = readFile( dir + "/consumer-trace.txt" );
+    std::ostringstream row;
+    row << ns3::NanoSeconds( 1000000000 ) << "\t7\t"
+        << ns3::NanoSeconds( 2500 ) << "\n";
+    BOOST_CHECK_EQUAL( consumer.compare( 0, 9, "# 1. Time" ), 0 );
+    BOOST_REQUIRE_GE( consumer.size(), row.str().size() );
+    BOOST_CHECK_EQUAL( consumer.substr( consumer.size() - row.str().size() ),
+                       row.str() );
+
+    // traces without records aren't written
+    std::ifstream validation( dir + "/validation-trace.txt" );
+    BOOST_CHECK( !validation.good() );
+}
+
+BOOST_AUTO_TEST_CASE( MissingFile )
+{
+    BOOST_CHECK( !ConvertBinaryTraces( dir + "/missing.bin", dir ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};
+};
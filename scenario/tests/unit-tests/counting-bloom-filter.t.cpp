@@ -0,0 +1,102 @@
+#include "counting-bloom-filter.hpp"
+#include "boost-test.hpp"
+#include <random>
+#include <vector>
+
+namespace ndntac
+{
+
+namespace
+{
+
+bloom_parameters
+makeParams( unsigned long long int n, double fpp )
+{
+    bloom_parameters params;
+    params.projected_element_count = n;
+    params.false_positive_probability = fpp;
+    params.compute_optimal_parameters();
+    return params;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( TestCountingBloomFilter )
+
+BOOST_AUTO_TEST_CASE( InsertErase )
+{
+    CountingBloomFilter filter( makeParams( 100, 0.01 ) );
+    filter.insert_digest( 1, 2 );
+    BOOST_CHECK( filter.contains_digest( 1, 2 ) );
+    BOOST_CHECK_EQUAL( filter.element_count(), 1 );
+
+    BOOST_CHECK( filter.erase_digest( 1, 2 ) );
+    BOOST_CHECK( !filter.contains_digest( 1, 2 ) );
+    BOOST_CHECK_EQUAL( filter.element_count(), 0 );
+
+    // nothing left to erase
+    BOOST_CHECK( !filter.erase_digest( 1, 2 ) );
+}
+
+BOOST_AUTO_TEST_CASE( EraseKeepsOtherKeys )
+{
+    CountingBloomFilter filter( makeParams( 10000, 0.01 ) );
+    std::mt19937_64 rng( 1 );
+    std::vector< std::pair< uint64_t, uint64_t > > keys;
+    for( int i = 0 ; i < 10000 ; i++ )
+    {
+        keys.emplace_back( rng(), rng() );
+        filter.insert_digest( keys.back().first, keys.back().second );
+    }
+
+    // erasing inserted keys never causes false negatives
+    // for the ones that are left
+    for( size_t i = 0 ; i < keys.size() ; i += 2 )
+        BOOST_CHECK( filter.erase_digest( keys[i].first, keys[i].second ) );
+    for( size_t i = 1 ; i < keys.size() ; i += 2 )
+        BOOST_CHECK( filter.contains_digest( keys[i].first, keys[i].second ) );
+    BOOST_CHECK_EQUAL( filter.element_count(), 5000 );
+
+    // most of the erased keys are gone, the rest are
+    // false positives of the remaining ones
+    int remaining = 0;
+    for( size_t i = 0 ; i < keys.size() ; i += 2 )
+    {
+        if( filter.contains_digest( keys[i].first, keys[i].second ) )
+            remaining++;
+    }
+    BOOST_CHECK_LE( remaining, 5000*0.02 );
+}
+
+BOOST_AUTO_TEST_CASE( SaturatedCountersStick )
+{
+    CountingBloomFilter filter( makeParams( 100, 0.01 ) );
+    const int inserts = CountingBloomFilter::MAX_COUNT + 5;
+    for( int i = 0 ; i < inserts ; i++ )
+        filter.insert_digest( 1, 2 );
+
+    // the counters' true counts were lost, so
+    // the key can't be erased anymore
+    for( int i = 0 ; i < inserts ; i++ )
+        BOOST_CHECK( filter.erase_digest( 1, 2 ) );
+    BOOST_CHECK( filter.contains_digest( 1, 2 ) );
+}
+
+BOOST_AUTO_TEST_CASE( EffectiveFpp )
+{
+    CountingBloomFilter filter( makeParams( 1000, 0.01 ) );
+    BOOST_CHECK_EQUAL( filter.effective_fpp(), 0 );
+
+    std::mt19937_64 rng( 2 );
+    for( int i = 0 ; i < 1000 ; i++ )
+        filter.insert_digest( rng(), rng() );
+    BOOST_CHECK_CLOSE( filter.effective_fpp(), 0.01, 20 );
+
+    filter.clear();
+    BOOST_CHECK_EQUAL( filter.element_count(), 0 );
+    BOOST_CHECK_EQUAL( filter.effective_fpp(), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};
@@ -0,0 +1,108 @@
+#include "exact-auth-cache.hpp"
+#include "ns3/ndnSIM/utils/dummy-keychain.hpp"
+#include "boost-test.hpp"
+
+namespace ndntac
+{
+
+namespace
+{
+
+// validity periods are rounded to seconds and are part of
+// the fingerprint, so all tags are timed from the same point;
+// otherwise two tags built in different seconds would differ
+const ndn::time::system_clock::TimePoint START
+    = ndn::time::system_clock::now();
+
+// tags only differ by their route hash, expiring the
+// given time from the start of the tests
+ndn::AuthTag
+makeTag( uint64_t route_hash,
+         ndn::time::system_clock::Duration expires_in
+         = ndn::time::days( 1 ) )
+{
+    ndn::AuthTag tag;
+    tag.setPrefix( ndn::Name( "/producer" ) );
+    tag.setAccessLevel( 1 );
+    tag.setRouteHash( route_hash );
+    tag.setConsumerLocator( ndn::KeyLocator() );
+    tag.setSignature( ndn::security::DUMMY_NDN_SIGNATURE );
+    tag.setKeyLocator( ndn::KeyLocator( ndn::Name( "/producer" ) ) );
+    tag.setActivationTime( START - ndn::time::days( 1 ) );
+    tag.setExpirationTime( START + expires_in );
+    return tag;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( TestExactAuthCache )
+
+BOOST_AUTO_TEST_CASE( InsertContainsErase )
+{
+    ExactAuthCache cache( 16 );
+    ndn::AuthTag tag = makeTag( 1 );
+    BOOST_CHECK( !cache.contains( tag ) );
+
+    cache.insert( tag );
+    BOOST_CHECK( cache.contains( tag ) );
+    BOOST_CHECK( !cache.contains( makeTag( 2 ) ) );
+    BOOST_CHECK_EQUAL( cache.size(), 1 );
+
+    // inserting again doesn't add another entry
+    cache.insert( tag );
+    BOOST_CHECK_EQUAL( cache.size(), 1 );
+
+    BOOST_CHECK( cache.erase( tag ) );
+    BOOST_CHECK( !cache.contains( tag ) );
+    BOOST_CHECK( !cache.erase( tag ) );
+    BOOST_CHECK_EQUAL( cache.size(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( ExpiredTagsMiss )
+{
+    ExactAuthCache cache( 16 );
+    ndn::AuthTag tag = makeTag( 1, -ndn::time::seconds( 10 ) );
+    cache.insert( tag );
+    BOOST_CHECK( !cache.contains( tag ) );
+}
+
+BOOST_AUTO_TEST_CASE( TagsWithoutValidityPeriod )
+{
+    // tags without a validity period never expire
+    ExactAuthCache cache( 16 );
+    ndn::AuthTag tag;
+    tag.setRouteHash( 1 );
+    tag.setSignature( ndn::security::DUMMY_NDN_SIGNATURE );
+    tag.setKeyLocator( ndn::KeyLocator( ndn::Name( "/producer" ) ) );
+    cache.insert( tag );
+    BOOST_CHECK( cache.contains( tag ) );
+}
+
+BOOST_AUTO_TEST_CASE( FullCacheDropsInserts )
+{
+    ExactAuthCache cache( 100 );
+    for( uint64_t i = 0 ; i < 200 ; i++ )
+        cache.insert( makeTag( i ) );
+    BOOST_CHECK_EQUAL( cache.size(), 100 );
+    BOOST_CHECK( cache.contains( makeTag( 99 ) ) );
+    BOOST_CHECK( !cache.contains( makeTag( 100 ) ) );
+}
+
+BOOST_AUTO_TEST_CASE( EraseKeepsProbeSequences )
+{
+    // erasing shifts entries back instead of leaving tombstones,
+    // so the entries that are left must all still be found
+    ExactAuthCache cache( 1000 );
+    for( uint64_t i = 0 ; i < 1000 ; i++ )
+        cache.insert( makeTag( i ) );
+    for( uint64_t i = 0 ; i < 1000 ; i += 3 )
+        BOOST_CHECK( cache.erase( makeTag( i ) ) );
+
+    for( uint64_t i = 0 ; i < 1000 ; i++ )
+        BOOST_CHECK_EQUAL( cache.contains( makeTag( i ) ), i % 3 != 0 );
+    BOOST_CHECK_EQUAL( cache.size(), 666 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};
@@ -0,0 +1,64 @@
+#include "key-context-cache.hpp"
+#include "boost-test.hpp"
+
+namespace ndntac
+{
+
+BOOST_AUTO_TEST_SUITE( TestKeyContextCache )
+
+BOOST_AUTO_TEST_CASE( FindInsert )
+{
+    KeyContextCache cache( 4 );
+    ndn::KeyLocator trusted( ndn::Name( "/trusted/KEY" ) );
+    ndn::KeyLocator untrusted( ndn::Name( "/untrusted/KEY" ) );
+    BOOST_CHECK( cache.find( trusted ) == nullptr );
+
+    cache.insert( trusted, KeyContextCache::Context{ true } );
+    cache.insert( untrusted, KeyContextCache::Context{ false } );
+    BOOST_REQUIRE( cache.find( trusted ) != nullptr );
+    BOOST_CHECK( cache.find( trusted )->trusted );
+    BOOST_REQUIRE( cache.find( untrusted ) != nullptr );
+    BOOST_CHECK( !cache.find( untrusted )->trusted );
+
+    // inserting again replaces the context
+    cache.insert( trusted, KeyContextCache::Context{ false } );
+    BOOST_CHECK( !cache.find( trusted )->trusted );
+    BOOST_CHECK_EQUAL( cache.size(), 2 );
+}
+
+BOOST_AUTO_TEST_CASE( EvictsLeastRecentlyUsed )
+{
+    KeyContextCache cache( 2 );
+    ndn::KeyLocator a( ndn::Name( "/a/KEY" ) );
+    ndn::KeyLocator b( ndn::Name( "/b/KEY" ) );
+    ndn::KeyLocator c( ndn::Name( "/c/KEY" ) );
+    cache.insert( a, KeyContextCache::Context{ true } );
+    cache.insert( b, KeyContextCache::Context{ true } );
+
+    // using a makes b the least recently used
+    cache.find( a );
+    cache.insert( c, KeyContextCache::Context{ true } );
+    BOOST_CHECK( cache.find( a ) != nullptr );
+    BOOST_CHECK( cache.find( b ) == nullptr );
+    BOOST_CHECK( cache.find( c ) != nullptr );
+    BOOST_CHECK_EQUAL( cache.size(), 2 );
+}
+
+BOOST_AUTO_TEST_CASE( ForNode )
+{
+    auto cache = KeyContextCache::forNode( 1, 4 );
+    BOOST_CHECK( KeyContextCache::forNode( 1, 4 ) == cache );
+    BOOST_CHECK( KeyContextCache::forNode( 2, 4 ) != cache );
+
+    // once no strategy holds a node's cache it's dropped,
+    // and the node gets a new empty one
+    cache->insert( ndn::KeyLocator( ndn::Name( "/a/KEY" ) ),
+                   KeyContextCache::Context{ true } );
+    cache.reset();
+    cache = KeyContextCache::forNode( 1, 4 );
+    BOOST_CHECK_EQUAL( cache->size(), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};
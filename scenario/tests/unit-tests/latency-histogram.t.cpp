@@ -0,0 +1,89 @@
+#include "latency-histogram.hpp"
+#include "boost-test.hpp"
+#include <cstdint>
+
+namespace ndntac
+{
+namespace tracers
+{
+
+BOOST_AUTO_TEST_SUITE( TestLatencyHistogram )
+
+BOOST_AUTO_TEST_CASE( Empty )
+{
+    LatencyHistogram histogram;
+    BOOST_CHECK_EQUAL( histogram.count(), 0 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 50 ), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( SmallValuesAreExact )
+{
+    LatencyHistogram histogram;
+    for( int64_t i = 1 ; i <= 100 ; i++ )
+        histogram.record( i );
+    BOOST_CHECK_EQUAL( histogram.count(), 100 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 0 ), 1 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 50 ), 50 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 99 ), 99 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 100 ), 100 );
+}
+
+BOOST_AUTO_TEST_CASE( RelativePrecision )
+{
+    // every value is reported to within 1/64 of itself,
+    // and never below it
+    int64_t values[] = { 128, 1000, 123457, 1000000007,
+                         (int64_t)1 << 40, INT64_MAX/3, INT64_MAX };
+    for( int64_t value : values )
+    {
+        LatencyHistogram histogram;
+        histogram.record( value );
+        int64_t reported = histogram.percentile( 100 );
+        BOOST_CHECK_GE( reported, value );
+        BOOST_CHECK_LE( reported - value, value/64 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( Percentiles )
+{
+    LatencyHistogram histogram;
+    for( int64_t i = 1 ; i <= 100000 ; i++ )
+        histogram.record( i*1000 );
+
+    BOOST_CHECK_CLOSE( (double)histogram.percentile( 50 ), 50000000, 1.6 );
+    BOOST_CHECK_CLOSE( (double)histogram.percentile( 90 ), 90000000, 1.6 );
+    BOOST_CHECK_CLOSE( (double)histogram.percentile( 99 ), 99000000, 1.6 );
+    BOOST_CHECK_CLOSE( (double)histogram.percentile( 99.9 ), 99900000, 1.6 );
+}
+
+BOOST_AUTO_TEST_CASE( NegativeValuesAreZero )
+{
+    LatencyHistogram histogram;
+    histogram.record( -5 );
+    BOOST_CHECK_EQUAL( histogram.count(), 1 );
+    BOOST_CHECK_EQUAL( histogram.percentile( 100 ), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( MergeAndReset )
+{
+    LatencyHistogram low, high;
+    for( int64_t i = 0 ; i < 100 ; i++ )
+    {
+        low.record( 10 );
+        high.record( 1000000 );
+    }
+
+    low.merge( high );
+    BOOST_CHECK_EQUAL( low.count(), 200 );
+    BOOST_CHECK_EQUAL( low.percentile( 25 ), 10 );
+    BOOST_CHECK_GE( low.percentile( 75 ), 1000000 );
+
+    low.reset();
+    BOOST_CHECK_EQUAL( low.count(), 0 );
+    BOOST_CHECK_EQUAL( low.percentile( 50 ), 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};
+};
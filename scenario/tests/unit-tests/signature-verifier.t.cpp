@@ -0,0 +1,125 @@
+#include "signature-verifier.hpp"
+#include "ns3/ndnSIM/utils/dummy-keychain.hpp"
+#include "boost-test.hpp"
+
+namespace ndntac
+{
+
+namespace
+{
+
+// keys are generated the first time a locator signs and are
+// kept by the shared verifier, so each test uses its own names
+ndn::AuthTag
+makeTag( const ndn::Name& key_name, uint64_t route_hash = 1 )
+{
+    ndn::time::system_clock::TimePoint now
+        = ndn::time::system_clock::now();
+
+    ndn::AuthTag tag;
+    tag.setPrefix( ndn::Name( "/producer" ) );
+    tag.setAccessLevel( 1 );
+    tag.setRouteHash( route_hash );
+    tag.setConsumerLocator( ndn::KeyLocator() );
+    tag.setSignature( ndn::security::DUMMY_NDN_SIGNATURE );
+    tag.setKeyLocator( ndn::KeyLocator( key_name ) );
+    tag.setActivationTime( now - ndn::time::days( 1 ) );
+    tag.setExpirationTime( now + ndn::time::days( 1 ) );
+    return tag;
+}
+
+// flips a bit of the signature value
+void
+tamper( ndn::AuthTag& tag )
+{
+    const ndn::Block& value = tag.getSignature().getValue();
+    auto buffer = std::make_shared< ndn::Buffer >( value.value(),
+                                                   value.value_size() );
+    (*buffer)[0] ^= 1;
+    tag.setSignatureValue( ndn::Block( ndn::tlv::SignatureValue, buffer ) );
+}
+
+void
+checkRoundTrip( SignatureVerifier::Mode mode,
+                uint32_t key_size,
+                const ndn::Name& key_name )
+{
+    SignatureVerifier& verifier = SignatureVerifier::get();
+
+    ndn::AuthTag tag = makeTag( key_name );
+    verifier.sign( tag, mode, key_size );
+    BOOST_CHECK( tag.getSignature().getType()
+                 == ( mode == SignatureVerifier::RsaSignatures
+                      ? ndn::tlv::SignatureSha256WithRsa
+                      : ndn::tlv::SignatureSha256WithEcdsa ) );
+
+    // the published key is trusted, at the measured load cost
+    ns3::Time delay;
+    BOOST_CHECK( verifier.loadKey( tag.getKeyLocator(), mode, delay ) );
+    BOOST_CHECK( delay > ns3::Seconds( 0 ) );
+
+    delay = ns3::Seconds( 0 );
+    BOOST_CHECK( verifier.verify( tag, mode, delay ) );
+    BOOST_CHECK( delay > ns3::Seconds( 0 ) );
+
+    // a second tag signed with the same key
+    ndn::AuthTag other = makeTag( key_name, 2 );
+    verifier.sign( other, mode, key_size );
+    BOOST_CHECK( verifier.verify( other, mode, delay ) );
+
+    // a tampered signature changes the fingerprint, so it's
+    // verified again rather than answered from the results
+    tamper( other );
+    BOOST_CHECK( !verifier.verify( other, mode, delay ) );
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE( TestSignatureVerifier )
+
+BOOST_AUTO_TEST_CASE( RsaRoundTrip )
+{
+    checkRoundTrip( SignatureVerifier::RsaSignatures, 1024,
+                    ndn::Name( "/producer/rsa/KEY" ) );
+}
+
+BOOST_AUTO_TEST_CASE( EcdsaRoundTrip )
+{
+    checkRoundTrip( SignatureVerifier::EcdsaSignatures, 256,
+                    ndn::Name( "/producer/ecdsa/KEY" ) );
+}
+
+BOOST_AUTO_TEST_CASE( UnpublishedKey )
+{
+    SignatureVerifier& verifier = SignatureVerifier::get();
+
+    // nothing was signed with this key, so it was never published
+    ndn::AuthTag tag = makeTag( ndn::Name( "/producer/unknown/KEY" ) );
+    ns3::Time delay;
+    BOOST_CHECK( !verifier.loadKey( tag.getKeyLocator(),
+                                    SignatureVerifier::RsaSignatures,
+                                    delay ) );
+    BOOST_CHECK( !verifier.verify( tag, SignatureVerifier::RsaSignatures,
+                                   delay ) );
+}
+
+BOOST_AUTO_TEST_CASE( DummySignatures )
+{
+    SignatureVerifier& verifier = SignatureVerifier::get();
+
+    // dummy tags are left unsigned and checked by their first byte
+    ndn::AuthTag tag = makeTag( ndn::Name( "/producer/dummy/KEY" ) );
+    verifier.sign( tag, SignatureVerifier::DummySignatures, 0 );
+    ns3::Time delay = ns3::Seconds( 1 );
+    bool expected = tag.getSignature().getValue().value_size() > 0
+                 && tag.getSignature().getValue().value()[0] != 0;
+    BOOST_CHECK_EQUAL( verifier.verify( tag,
+                                        SignatureVerifier::DummySignatures,
+                                        delay ),
+                       expected );
+    BOOST_CHECK( delay == ns3::Seconds( 1 ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,117 @@
+#include "trace-sink.hpp"
+#include "tests-common.hpp"
+#include "boost-test.hpp"
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace ndntac
+{
+namespace tracers
+{
+
+namespace
+{
+
+TraceRecord
+makeRecord( int64_t i )
+{
+    return TraceRecord{ i*1000, i*i, (uint16_t)( i % 9 ),
+                        (uint8_t)( i % 4 ), (uint8_t)( i % 3 ), 0 };
+}
+
+std::vector< TraceRecord >
+readAll( const std::string& file )
+{
+    std::ifstream in( file, std::ios::in | std::ios::binary );
+    std::vector< TraceRecord > records;
+    TraceRecord record;
+    while( TraceSink::read( in, record ) )
+        records.push_back( record );
+    return records;
+}
+
+struct TraceSinkFixture : TempDirFixture
+{
+    TraceSinkFixture()
+      : file( dir + "/trace.bin" )
+    { }
+
+    std::string file;
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE( TestTraceSink, TraceSinkFixture )
+
+BOOST_AUTO_TEST_CASE( WritesAllRecordsInOrder )
+{
+    // many times the buffer's capacity, so the simulation
+    // side has to wait for the writer to drain it
+    const int64_t count = 10000;
+    {
+        TraceSink sink( file, 16 );
+        BOOST_REQUIRE( sink.good() );
+        for( int64_t i = 0 ; i < count ; i++ )
+            sink.push( makeRecord( i ) );
+    }
+
+    std::vector< TraceRecord > records = readAll( file );
+    BOOST_REQUIRE_EQUAL( records.size(), (size_t)count );
+    for( int64_t i = 0 ; i < count ; i++ )
+    {
+        TraceRecord expected = makeRecord( i );
+        BOOST_CHECK_EQUAL( records[i].time, expected.time );
+        BOOST_CHECK_EQUAL( records[i].value, expected.value );
+        BOOST_CHECK_EQUAL( records[i].trace, expected.trace );
+        BOOST_CHECK_EQUAL( records[i].column, expected.column );
+        BOOST_CHECK_EQUAL( records[i].kind, expected.kind );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( FlushesPartialBuffer )
+{
+    // fewer records than wake the writer, they're
+    // only written when the sink is destroyed
+    {
+        TraceSink sink( file, 1024 );
+        for( int64_t i = 0 ; i < 3 ; i++ )
+            sink.push( makeRecord( i ) );
+    }
+    BOOST_CHECK_EQUAL( readAll( file ).size(), 3 );
+}
+
+BOOST_AUTO_TEST_CASE( EmptySink )
+{
+    {
+        TraceSink sink( file );
+    }
+    BOOST_CHECK_EQUAL( readAll( file ).size(), 0 );
+}
+
+BOOST_AUTO_TEST_CASE( BadFile )
+{
+    TraceSink sink( "/nonexistent-directory/trace.bin" );
+    BOOST_CHECK( !sink.good() );
+
+    // pushing to a bad sink does nothing
+    sink.push( makeRecord( 1 ) );
+}
+
+BOOST_AUTO_TEST_CASE( ReadTruncatedRecord )
+{
+    TraceRecord record = makeRecord( 1 );
+    std::string wire( (const char*)&record, sizeof( record ) );
+
+    std::istringstream full( wire );
+    BOOST_CHECK( TraceSink::read( full, record ) );
+    BOOST_CHECK( !TraceSink::read( full, record ) );
+
+    std::istringstream truncated( wire.substr( 0, sizeof( record ) - 1 ) );
+    BOOST_CHECK( !TraceSink::read( truncated, record ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+};
+};